@@ -0,0 +1,115 @@
+import argparse
+from pathlib import Path
+
+PROFILES = ["functions", "nesting", "arrays", "imports", "strings"]
+
+def write(path: Path, lines):
+   path.parent.mkdir(parents=True, exist_ok=True)
+   path.write_text("\n".join(lines) + "\n")
+   return path
+
+def gen_functions(size: int, out_dir: Path) -> Path:
+   lines = []
+   for i in range(size):
+      lines += [
+         f"func f{i}(a: int, b: int): int {{",
+         f"    var x: int = a * {i % 7 + 1} + b;",
+         f"    if (x > {i}) {{",
+         f"        x = x - b;",
+         f"    }}",
+         f"    ret x;",
+         f"}}",
+         "",
+      ]
+   lines += ["func main(): int {", "    var acc: int = 0;"]
+   lines += [f"    acc += f{i}(acc, {i});" for i in range(size)]
+   lines += ["    ret 0;", "}"]
+   return write(out_dir / "main.vx", lines)
+
+def gen_nesting(size: int, out_dir: Path) -> Path:
+   ops = ["+", "*", "-", "+", "%", "*"]
+   expr = "a"
+   for k in range(size):
+      expr = f"({expr} {ops[k % len(ops)]} {k % 9 + 1})"
+
+   depth = min(size, 64)
+   lines = ["func nested(a: int): int {", f"    var r: int = {expr};"]
+   for k in range(depth):
+      lines.append("    " * (k + 1) + f"if (r > {k}) {{")
+      lines.append("    " * (k + 2) + f"r = r - {k % 3 + 1};")
+   for k in reversed(range(depth)):
+      lines.append("    " * (k + 1) + "}")
+   lines += ["    ret r;", "}", "", "func main(): int {", "    var v: int = nested(7);", "    ret 0;", "}"]
+   return write(out_dir / "main.vx", lines)
+
+def gen_arrays(size: int, out_dir: Path) -> Path:
+   per_line = 32
+   values = [str((i * 31) % 1000) for i in range(size)]
+   body = [", ".join(values[i:i + per_line]) for i in range(0, len(values), per_line)]
+   lines = ["func main(): int {", "    var data: int[] = {"]
+   lines += ["        " + row + ("," if n + 1 < len(body) else "") for n, row in enumerate(body)]
+   lines += [
+      "    };",
+      "    var total: int = 0;",
+      "    for (var i = 0; i < len(data); i++) {",
+      "        total += data[i];",
+      "    }",
+      "    ret 0;",
+      "}",
+   ]
+   return write(out_dir / "main.vx", lines)
+
+def gen_imports(size: int, out_dir: Path) -> Path:
+   # The tokenizer only resolves imports in the entry file, so the chain is
+   # expressed as one import per module rather than module-to-module.
+   modules = max(1, size // 10)
+   for m in range(modules):
+      lines = []
+      for j in range(10):
+         lines += [
+            f"func m{m}_f{j}(x: int): int {{",
+            f"    ret x * {j + 1} + {m};",
+            f"}}",
+            "",
+         ]
+      write(out_dir / f"mod{m}.vx", lines)
+
+   lines = [f"import mod{m}" for m in range(modules)]
+   lines += ["", "func main(): int {", "    var acc: int = 0;"]
+   lines += [f"    acc += m{m}_f{m % 10}(acc);" for m in range(modules)]
+   lines += ["    ret 0;", "}"]
+   return write(out_dir / "main.vx", lines)
+
+def gen_strings(size: int, out_dir: Path) -> Path:
+   literal_len = size * 64
+   alphabet = "abcdefghijklmnopqrstuvwxyz0123456789"
+   lines = ["func main(): int {", "    var total: int = 0;"]
+   for s in range(8):
+      text = "".join(alphabet[(i + s) % len(alphabet)] for i in range(literal_len))
+      lines += [f"    var s{s}: string = \"{text}\";", f"    total += len(s{s});"]
+   lines += ["    ret 0;", "}"]
+   return write(out_dir / "main.vx", lines)
+
+GENERATORS = {
+   "functions": gen_functions,
+   "nesting": gen_nesting,
+   "arrays": gen_arrays,
+   "imports": gen_imports,
+   "strings": gen_strings,
+}
+
+def generate(profile: str, size: int, out_dir: Path) -> Path:
+   return GENERATORS[profile](size, Path(out_dir))
+
+def main():
+   parser = argparse.ArgumentParser(description="Generate synthetic Vexar programs for compiler benchmarks")
+   parser.add_argument("--profile", choices=PROFILES, required=True)
+   parser.add_argument("--size", type=int, default=1000)
+   parser.add_argument("--out", type=Path, required=True)
+   args = parser.parse_args()
+
+   path = generate(args.profile, args.size, args.out)
+   print(f"Generated {args.profile} ({args.size}) -> {path}")
+
+if __name__ == "__main__":
+   main()
@@ -0,0 +1,126 @@
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from generate import PROFILES, generate
+
+project_root = Path(__file__).resolve().parents[2]
+default_compiler = project_root / "build" / "dist" / ("vexar.exe" if os.name == "nt" else "vexar")
+
+# metric -> True when larger values are better
+METRICS = {
+   "tokens_per_sec": True,
+   "ast_nodes_per_sec": True,
+   "ir_instructions_per_sec": True,
+   "optimise_seconds": False,
+   "end_to_end_seconds": False,
+}
+
+def run_once(compiler: Path, program: Path, level: int, target: str, work_dir: Path):
+   stats_file = work_dir / f"stats-O{level}.json"
+   output = work_dir / f"out-O{level}"
+   cmd = [str(compiler), program.name, f"-O{level}", "-o", str(output), f"--stats={stats_file}"]
+   if target:
+      cmd.append(f"--target={target}")
+
+   start = time.perf_counter()
+   proc = subprocess.run(cmd, cwd=program.parent, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+   wall = time.perf_counter() - start
+
+   if proc.returncode != 0 or not stats_file.exists():
+      raise RuntimeError(f"compile failed ({' '.join(cmd)}):\n{proc.stderr}")
+
+   stats = json.loads(stats_file.read_text())
+   stats["wall"] = wall
+   return stats
+
+def summarise(samples):
+   def median(get):
+      return statistics.median(get(s) for s in samples)
+
+   phases = lambda name: median(lambda s: s["phases"].get(name, 0.0))
+   first = samples[0]
+   tokenize, parse, codegen = phases("tokenize"), phases("parse"), phases("codegen")
+
+   return {
+      "tokens": first["tokens"],
+      "ast_nodes": first["ast_nodes"],
+      "ir_instructions": first["ir_instructions"],
+      "ir_instructions_optimised": first["ir_instructions_optimised"],
+      "tokenize_seconds": tokenize,
+      "parse_seconds": parse,
+      "codegen_seconds": codegen,
+      "optimise_seconds": phases("optimise"),
+      "emit_seconds": phases("emit"),
+      "tokens_per_sec": first["tokens"] / tokenize if tokenize else 0.0,
+      "ast_nodes_per_sec": first["ast_nodes"] / parse if parse else 0.0,
+      "ir_instructions_per_sec": first["ir_instructions"] / codegen if codegen else 0.0,
+      "end_to_end_seconds": median(lambda s: s["wall"]),
+   }
+
+def compare(results, baseline, threshold):
+   regressions = []
+   print(f"\n{'benchmark':<28}{'metric':<26}{'baseline':>14}{'current':>14}{'delta':>10}")
+   for key, current in sorted(results.items()):
+      if key not in baseline:
+         continue
+      for metric, higher_is_better in METRICS.items():
+         old, new = baseline[key].get(metric), current.get(metric)
+         if not old or new is None:
+            continue
+         delta = (new - old) / old
+         worse = -delta if higher_is_better else delta
+         flag = "  REGRESSION" if worse > threshold else ""
+         print(f"{key:<28}{metric:<26}{old:>14.4g}{new:>14.4g}{delta:>+9.1%}{flag}")
+         if flag:
+            regressions.append((key, metric, delta))
+   return regressions
+
+def main():
+   parser = argparse.ArgumentParser(description="Vexar compiler throughput benchmarks")
+   parser.add_argument("--compiler", type=Path, default=default_compiler)
+   parser.add_argument("--profiles", nargs="+", choices=PROFILES, default=PROFILES)
+   parser.add_argument("--sizes", nargs="+", type=int, default=[100, 1000])
+   parser.add_argument("--levels", nargs="+", type=int, default=[0, 1, 2, 3, 4, 5])
+   parser.add_argument("--repeat", type=int, default=3)
+   parser.add_argument("--target", default="", help="compiler target, e.g. 'llvm' to skip native linking")
+   parser.add_argument("--work-dir", type=Path, default=project_root / "build" / "bench" / "compiler")
+   parser.add_argument("--output", type=Path, default=None, help="write results JSON here")
+   parser.add_argument("--baseline", type=Path, default=None, help="compare against a saved results JSON")
+   parser.add_argument("--threshold", type=float, default=0.10, help="allowed relative slowdown before failing")
+   args = parser.parse_args()
+
+   results = {}
+   for profile in args.profiles:
+      for size in args.sizes:
+         program_dir = args.work_dir / f"{profile}-{size}"
+         program = generate(profile, size, program_dir)
+         for level in args.levels:
+            key = f"{profile}-{size}-O{level}"
+            samples = [run_once(args.compiler, program, level, args.target, program_dir) for _ in range(args.repeat)]
+            results[key] = summarise(samples)
+            r = results[key]
+            print(f"{key:<28}{r['tokens_per_sec']:>14.0f} tok/s{r['ast_nodes_per_sec']:>14.0f} nodes/s"
+                  f"{r['ir_instructions_per_sec']:>14.0f} instr/s  opt {r['optimise_seconds']:.4f}s  total {r['end_to_end_seconds']:.4f}s")
+
+   report = {"compiler": str(args.compiler), "target": args.target or "native", "results": results}
+   if args.output:
+      args.output.parent.mkdir(parents=True, exist_ok=True)
+      args.output.write_text(json.dumps(report, indent=2))
+      print(f"\nWrote results -> {args.output}")
+
+   if args.baseline:
+      baseline = json.loads(args.baseline.read_text())["results"]
+      regressions = compare(results, baseline, args.threshold)
+      if regressions:
+         print(f"\n{len(regressions)} metric(s) regressed by more than {args.threshold:.0%}")
+         sys.exit(1)
+
+if __name__ == "__main__":
+   main()
@@ -0,0 +1,24 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int gcd(int a, int b) { return b == 0 ? a : gcd(b, a % b); }
+static int clamp(int x, int lo, int hi) { return x < lo ? lo : (x > hi ? hi : x); }
+static int ipow(int x, int y) { return y == 0 ? 1 : x * ipow(x, y - 1); }
+
+int main(void) {
+    int total = 0;
+
+    for (int i = 1; i < 2000000; i++) {
+        total += gcd(i, 360) + clamp(i % 100, 10, 90) + abs(50 - i % 100) + ipow(i % 4, 3);
+        total = total % 1000003;
+    }
+
+    for (int j = 0; j < 1000000; j++) {
+        float x = (float)(j % 1000) / 8.0f;
+        total = (total + (int)floorf(x) + (int)ceilf(x) + (int)roundf(x) + (int)truncf(x)) % 1000003;
+    }
+
+    printf("%d\n", total);
+    return 0;
+}
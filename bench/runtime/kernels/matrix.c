@@ -0,0 +1,32 @@
+#include <stdio.h>
+
+static int a[128][128];
+static int b[128][128];
+static int c[128][128];
+
+int main(void) {
+    for (int i = 0; i < 128; i++) {
+        for (int j = 0; j < 128; j++) {
+            a[i][j] = (i + j) % 17;
+            b[i][j] = (i * j) % 13;
+        }
+    }
+
+    int checksum = 0;
+    for (int r = 0; r < 20; r++) {
+        for (int i = 0; i < 128; i++) {
+            for (int j = 0; j < 128; j++) {
+                int acc = 0;
+                for (int k = 0; k < 128; k++) {
+                    acc += a[i][k] * b[k][j];
+                }
+                c[i][j] = acc + r;
+            }
+        }
+        int idx = (r * 37) % 16384;
+        checksum = (checksum + c[idx / 128][idx % 128]) % 1000003;
+    }
+
+    printf("%d\n", checksum);
+    return 0;
+}
@@ -0,0 +1,8 @@
+#include <stdio.h>
+
+int main(void) {
+    for (int i = 0; i < 200000; i++) {
+        printf("%d\n", i);
+    }
+    return 0;
+}
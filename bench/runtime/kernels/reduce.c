@@ -0,0 +1,20 @@
+#include <stdio.h>
+
+int main(void) {
+    int data[4096];
+    for (int i = 0; i < 4096; i++) {
+        data[i] = (i * 7) % 1000;
+    }
+
+    int total = 0;
+    for (int r = 0; r < 20000; r++) {
+        int sum = 0;
+        for (int i = 0; i < 4096; i++) {
+            sum += data[i];
+        }
+        total = (total + sum + r) % 1000003;
+    }
+
+    printf("%d\n", total);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int saxpy(float* restrict y, const float* restrict x, float a, int n) {
+    for (int i = 0; i < n; i++) {
+        y[i] = a * x[i] + y[i];
+    }
+    return 0;
+}
+
+int main(void) {
+    float* x = malloc(4096 * sizeof(float));
+    float* y = malloc(4096 * sizeof(float));
+    for (int i = 0; i < 4096; i++) {
+        x[i] = (float)(i % 100) / 4.0f;
+        y[i] = (float)(i % 7);
+    }
+
+    int total = 0;
+    for (int r = 0; r < 20000; r++) {
+        saxpy(y, x, 0.5f, 4096);
+        total = (total + (int)y[(r * 37) % 4096]) % 1000003;
+        y[(r * 37) % 4096] = 1.0f;
+    }
+
+    printf("%d\n", total);
+    free(x);
+    free(y);
+    return 0;
+}
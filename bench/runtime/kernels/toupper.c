@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char* to_upper(const char* input) {
+    size_t n = strlen(input);
+    char* result = malloc(n + 1);
+    for (size_t i = 0; i < n; i++) {
+        char c = input[i];
+        result[i] = (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+    }
+    result[n] = '\0';
+    return result;
+}
+
+int main(void) {
+    const char* text = "the quick brown fox jumps over the lazy dog 0123456789";
+    int total = 0;
+
+    for (int r = 0; r < 2000; r++) {
+        char* upper = to_upper(text);
+        total = (total + (int)strlen(upper) + r) % 1000003;
+        free(upper);
+    }
+
+    char* upper = to_upper(text);
+    printf("%s\n", upper);
+    free(upper);
+    printf("%d\n", total);
+    return 0;
+}
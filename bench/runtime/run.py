@@ -0,0 +1,123 @@
+import argparse
+import json
+import os
+import shutil
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+project_root = Path(__file__).resolve().parents[2]
+kernels_dir = Path(__file__).resolve().parent / "kernels"
+default_compiler = project_root / "build" / "dist" / ("vexar.exe" if os.name == "nt" else "vexar")
+exe_suffix = ".exe" if os.name == "nt" else ""
+
+# vexar -O level -> equivalent clang flag
+CLANG_LEVELS = {0: "-O0", 1: "-O1", 2: "-O2", 3: "-O3", 4: "-Os", 5: "-Oz"}
+
+KERNELS = sorted(p.stem for p in kernels_dir.glob("*.vx") if p.with_suffix(".c").exists())
+
+def build_vexar(compiler: Path, kernel: str, level: int, work_dir: Path) -> Path:
+   output = work_dir / f"{kernel}-vx-O{level}"
+   source = (kernels_dir / f"{kernel}.vx").relative_to(project_root)
+   # run from the project root so `import std/...` resolves
+   cmd = [str(compiler), str(source), f"-O{level}", "-o", str(output)]
+   # the work dir is reused between runs, so a binary left over from an earlier build must not pass for this one
+   candidates = (output, output.with_name(output.name + ".exe"))
+   for candidate in candidates:
+      candidate.unlink(missing_ok=True)
+   proc = subprocess.run(cmd, cwd=project_root, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+   if proc.returncode != 0:
+      raise RuntimeError(f"vexar build failed ({' '.join(cmd)}):\n{proc.stderr}")
+   for candidate in candidates:
+      if candidate.exists():
+         return candidate
+   raise RuntimeError(f"vexar build produced no binary ({' '.join(cmd)}):\n{proc.stderr}")
+
+def build_c(clang: str, kernel: str, level: int, work_dir: Path) -> Path:
+   output = work_dir / f"{kernel}-c-O{level}{exe_suffix}"
+   cmd = [clang, CLANG_LEVELS[level], str(kernels_dir / f"{kernel}.c"), "-o", str(output)]
+   if os.name != "nt":
+      cmd.append("-lm")
+   proc = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+   if proc.returncode != 0:
+      raise RuntimeError(f"clang build failed ({' '.join(cmd)}):\n{proc.stderr}")
+   return output
+
+def time_binary(binary: Path, repeat: int):
+   times, output = [], None
+   for _ in range(repeat):
+      start = time.perf_counter()
+      proc = subprocess.run([str(binary)], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+      times.append(time.perf_counter() - start)
+      output = proc.stdout
+   return statistics.median(times), output
+
+def compare(results, baseline, threshold):
+   regressions = []
+   print(f"\n{'benchmark':<20}{'baseline':>12}{'current':>12}{'delta':>10}")
+   for key, current in sorted(results.items()):
+      old = baseline.get(key, {}).get("ratio")
+      new = current.get("ratio")
+      if not old or new is None:
+         continue
+      delta = (new - old) / old
+      flag = "  REGRESSION" if delta > threshold else ""
+      print(f"{key:<20}{old:>12.3f}{new:>12.3f}{delta:>+9.1%}{flag}")
+      if flag:
+         regressions.append((key, delta))
+   return regressions
+
+def main():
+   parser = argparse.ArgumentParser(description="Vexar generated-code benchmarks against equivalent C")
+   parser.add_argument("--compiler", type=Path, default=default_compiler)
+   parser.add_argument("--clang", default=shutil.which("clang") or "clang")
+   parser.add_argument("--kernels", nargs="+", choices=KERNELS, default=KERNELS)
+   parser.add_argument("--levels", nargs="+", type=int, choices=sorted(CLANG_LEVELS), default=sorted(CLANG_LEVELS))
+   parser.add_argument("--repeat", type=int, default=5)
+   parser.add_argument("--work-dir", type=Path, default=project_root / "build" / "bench" / "runtime")
+   parser.add_argument("--output", type=Path, default=None, help="write results JSON here")
+   parser.add_argument("--baseline", type=Path, default=None, help="compare against a saved results JSON")
+   parser.add_argument("--threshold", type=float, default=0.10, help="allowed relative growth of the vexar/C ratio")
+   args = parser.parse_args()
+
+   args.work_dir.mkdir(parents=True, exist_ok=True)
+   results, mismatches = {}, []
+
+   print(f"{'benchmark':<20}{'vexar (s)':>12}{'c (s)':>12}{'ratio':>10}  output")
+   for kernel in args.kernels:
+      for level in args.levels:
+         key = f"{kernel}-O{level}"
+         vx_time, vx_out = time_binary(build_vexar(args.compiler, kernel, level, args.work_dir), args.repeat)
+         c_time, c_out = time_binary(build_c(args.clang, kernel, level, args.work_dir), args.repeat)
+
+         matches = vx_out.replace(b"\r\n", b"\n") == c_out.replace(b"\r\n", b"\n")
+         if not matches:
+            mismatches.append(key)
+
+         ratio = vx_time / c_time if c_time else 0.0
+         results[key] = {"vexar_seconds": vx_time, "c_seconds": c_time, "ratio": ratio, "output_matches": matches}
+         print(f"{key:<20}{vx_time:>12.4f}{c_time:>12.4f}{ratio:>9.2f}x  {'ok' if matches else 'MISMATCH'}")
+
+   report = {"compiler": str(args.compiler), "clang": args.clang, "results": results}
+   if args.output:
+      args.output.parent.mkdir(parents=True, exist_ok=True)
+      args.output.write_text(json.dumps(report, indent=2))
+      print(f"\nWrote results -> {args.output}")
+
+   if mismatches:
+      print(f"\nOutput differs from C for: {', '.join(mismatches)}")
+
+   if args.baseline:
+      baseline = json.loads(args.baseline.read_text())["results"]
+      regressions = compare(results, baseline, args.threshold)
+      if regressions:
+         print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:.0%}")
+         sys.exit(1)
+
+   if mismatches:
+      sys.exit(1)
+
+if __name__ == "__main__":
+   main()
@@ -101,6 +101,8 @@ def main():
              list(project_root.glob("**/*.cc")) + \
              list(project_root.glob("**/*.c++")) + \
              list(project_root.glob("**/*.cxx"))
+   # bench/ holds standalone C programs with their own main()
+   sources = [src for src in sources if "bench" not in src.relative_to(project_root).parts]
 
    with ProcessPoolExecutor(max_workers=os.cpu_count()) as executor:
        futures = {executor.submit(compile_source, src): src for src in sources}
@@ -12,24 +12,21 @@ AeroIR::AeroIR(const std::string& moduleName) {
     module = std::make_unique<llvm::Module>(moduleName, *context);
     builder = std::make_unique<llvm::IRBuilder<>>(*context);
     currentFunction = nullptr;
+    diCompileUnit = nullptr;
+    diFile = nullptr;
     pushScope();
     setupBuiltins();
 }
 
 void AeroIR::setupBuiltins() {
-    mallocFunc = llvm::Function::Create(
-        llvm::FunctionType::get(i8ptr(), {i64()}, false),
-        llvm::Function::ExternalLinkage, "malloc", *module);
-    
-    freeFunc = llvm::Function::Create(
-        llvm::FunctionType::get(void_t(), {i8ptr()}, false),
-        llvm::Function::ExternalLinkage, "free", *module);
+    mallocFunc = runtimeFunction("malloc");
+    freeFunc = runtimeFunction("free");
         
     gcCleanupFunc = createBuiltinFunction("__gc_cleanup", void_t(), {});
     llvm::BasicBlock* gcEntry = llvm::BasicBlock::Create(*context, "entry", gcCleanupFunc);
     builder->SetInsertPoint(gcEntry);
-    for (auto ptr : gcPointers) {
-        builder->CreateCall(freeFunc, {ptr});
+    for (auto& [ptr, deallocator] : gcPointers) {
+        builder->CreateCall(deallocator, {ptr});
     }
     builder->CreateRetVoid();
 }
@@ -170,7 +167,7 @@ llvm::Value* AeroIR::constString(const std::string& str) {
 }
 
 llvm::Function* AeroIR::createFunction(const std::string& name, llvm::Type* retType, 
-                               const std::vector<llvm::Type*>& paramTypes) {
+                               const std::vector<llvm::Type*>& paramTypes, unsigned line) {
     llvm::FunctionType* funcType = llvm::FunctionType::get(retType, paramTypes, false);
     llvm::Function* func = llvm::Function::Create(funcType, 
                                                   llvm::Function::ExternalLinkage, 
@@ -178,6 +175,16 @@ llvm::Function* AeroIR::createFunction(const std::string& name, llvm::Type* retT
     currentFunction = func;
     llvm::BasicBlock* entry = llvm::BasicBlock::Create(*context, "entry", func);
     builder->SetInsertPoint(entry);
+    if (!targetCPU.empty()) func->addFnAttr("target-cpu", targetCPU);
+    if (!targetFeatures.empty()) func->addFnAttr("target-features", targetFeatures);
+    if (diBuilder) {
+        llvm::DISubroutineType* spType = diBuilder->createSubroutineType(diBuilder->getOrCreateTypeArray({}));
+        llvm::DISubprogram* sp = diBuilder->createFunction(diFile, name, name, diFile, line, spType, line,
+                                                           llvm::DINode::FlagPrototyped,
+                                                           llvm::DISubprogram::SPFlagDefinition);
+        func->setSubprogram(sp);
+        setSourceLocation(line, 0);
+    }
     pushScope();
     return func;
 }
@@ -196,6 +203,105 @@ llvm::Function* AeroIR::getBuiltinFunction(const std::string& name) {
     return builtinFuncs.count(name) ? builtinFuncs[name] : nullptr;
 }
 
+// libc entry points the generators call into. Each one is declared once per
+// module with the attributes clang would give it, so LLVM can hoist, CSE and
+// elide calls (e.g. strlen in a loop condition, unused malloc/free pairs).
+llvm::Function* AeroIR::runtimeFunction(const std::string& name) {
+    if (llvm::Function* existing = module->getFunction(name)) return existing;
+
+    llvm::Type* ptrTy = i8ptr();
+    llvm::FunctionType* funcType = nullptr;
+    if (name == "malloc") funcType = llvm::FunctionType::get(ptrTy, {i64()}, false);
+    else if (name == "aligned_alloc") funcType = llvm::FunctionType::get(ptrTy, {i64(), i64()}, false);
+    else if (name == "_aligned_malloc") funcType = llvm::FunctionType::get(ptrTy, {i64(), i64()}, false);
+    else if (name == "free" || name == "_aligned_free") funcType = llvm::FunctionType::get(void_t(), {ptrTy}, false);
+    else if (name == "strlen") funcType = llvm::FunctionType::get(i64(), {ptrTy}, false);
+    else if (name == "strcmp") funcType = llvm::FunctionType::get(i32(), {ptrTy, ptrTy}, false);
+    else if (name == "memcmp") funcType = llvm::FunctionType::get(i32(), {ptrTy, ptrTy, i64()}, false);
+    else if (name == "strchr") funcType = llvm::FunctionType::get(ptrTy, {ptrTy, i32()}, false);
+    else if (name == "atoi") funcType = llvm::FunctionType::get(i32(), {ptrTy}, false);
+    else if (name == "atof") funcType = llvm::FunctionType::get(f64(), {ptrTy}, false);
+    else if (name == "strtod") funcType = llvm::FunctionType::get(f64(), {ptrTy, ptrTy}, false);
+    else if (name == "printf") funcType = llvm::FunctionType::get(i32(), {ptrTy}, true);
+    else if (name == "sprintf") funcType = llvm::FunctionType::get(i32(), {ptrTy, ptrTy}, true);
+    else if (name == "fgets") funcType = llvm::FunctionType::get(ptrTy, {ptrTy, i32(), ptrTy}, false);
+    else if (name == "__acrt_iob_func") funcType = llvm::FunctionType::get(ptrTy, {i32()}, false);
+    else if (name == "exit") funcType = llvm::FunctionType::get(void_t(), {i32()}, false);
+    else return nullptr;
+
+    llvm::Function* func = llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, name, *module);
+    func->setDoesNotThrow();
+
+    auto noCapture = llvm::Attribute::getWithCaptureInfo(*context, llvm::CaptureInfo::none());
+    auto readArg = [&](unsigned i, bool capture = false) {
+        if (!capture) func->addParamAttr(i, noCapture);
+        func->addParamAttr(i, llvm::Attribute::ReadOnly);
+    };
+
+    if (name == "malloc") {
+        func->setWillReturn();
+        func->addRetAttr(llvm::Attribute::NoAlias);
+        func->addFnAttr(llvm::Attribute::getWithAllocSizeArgs(*context, 0, std::nullopt));
+        func->addFnAttr(llvm::Attribute::getWithAllocKind(*context, llvm::AllocFnKind::Alloc | llvm::AllocFnKind::Uninitialized));
+        func->addFnAttr("alloc-family", "malloc");
+        func->setMemoryEffects(llvm::MemoryEffects::inaccessibleMemOnly());
+    } else if (name == "aligned_alloc") {
+        func->setWillReturn();
+        func->addRetAttr(llvm::Attribute::NoAlias);
+        func->addParamAttr(0, llvm::Attribute::AllocAlign);
+        func->addFnAttr(llvm::Attribute::getWithAllocSizeArgs(*context, 1, std::nullopt));
+        func->addFnAttr(llvm::Attribute::getWithAllocKind(*context, llvm::AllocFnKind::Alloc | llvm::AllocFnKind::Uninitialized | llvm::AllocFnKind::Aligned));
+        func->addFnAttr("alloc-family", "malloc");
+        func->setMemoryEffects(llvm::MemoryEffects::inaccessibleMemOnly());
+    } else if (name == "_aligned_malloc") {
+        // Microsoft's CRT has no aligned_alloc; its aligned blocks are a separate family released by _aligned_free
+        func->setWillReturn();
+        func->addRetAttr(llvm::Attribute::NoAlias);
+        func->addParamAttr(1, llvm::Attribute::AllocAlign);
+        func->addFnAttr(llvm::Attribute::getWithAllocSizeArgs(*context, 0, std::nullopt));
+        func->addFnAttr(llvm::Attribute::getWithAllocKind(*context, llvm::AllocFnKind::Alloc | llvm::AllocFnKind::Uninitialized | llvm::AllocFnKind::Aligned));
+        func->addFnAttr("alloc-family", "_aligned_malloc");
+        func->setMemoryEffects(llvm::MemoryEffects::inaccessibleMemOnly());
+    } else if (name == "free" || name == "_aligned_free") {
+        func->setWillReturn();
+        func->addFnAttr(llvm::Attribute::getWithAllocKind(*context, llvm::AllocFnKind::Free));
+        func->addFnAttr("alloc-family", name == "free" ? "malloc" : "_aligned_malloc");
+        func->addParamAttr(0, llvm::Attribute::AllocatedPointer);
+        func->addParamAttr(0, noCapture);
+        func->setMemoryEffects(llvm::MemoryEffects::inaccessibleOrArgMemOnly());
+    } else if (name == "strlen" || name == "strcmp" || name == "memcmp" || name == "strchr") {
+        func->setWillReturn();
+        func->setDoesNotFreeMemory();
+        func->setMemoryEffects(llvm::MemoryEffects::argMemOnly(llvm::ModRefInfo::Ref));
+        readArg(0, name == "strchr");
+        if (name == "strcmp" || name == "memcmp") readArg(1);
+    } else if (name == "atoi" || name == "atof") {
+        func->setWillReturn();
+        func->setDoesNotFreeMemory();
+        func->setOnlyReadsMemory();
+        readArg(0);
+    } else if (name == "strtod") {
+        func->setWillReturn();
+        func->setDoesNotFreeMemory();
+        func->addParamAttr(0, llvm::Attribute::ReadOnly);
+        func->addParamAttr(1, noCapture);
+    } else if (name == "printf") {
+        func->setDoesNotFreeMemory();
+        readArg(0);
+    } else if (name == "sprintf") {
+        func->setDoesNotFreeMemory();
+        func->addParamAttr(0, noCapture);
+        readArg(1);
+    } else if (name == "fgets") {
+        func->addParamAttr(2, noCapture);
+    } else if (name == "exit") {
+        func->setDoesNotReturn();
+    }
+
+    builtinFuncs[name] = func;
+    return func;
+}
+
 void AeroIR::endFunction() {
     popScope();
     currentFunction = nullptr;
@@ -268,9 +374,10 @@ llvm::Value* AeroIR::load(llvm::Value* ptr) {
     }
     
     if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(ptr)) {
-        return builder->CreateLoad(alloca->getAllocatedType(), ptr);
+        return load(ptr, alloca->getAllocatedType());
     }
     
+    // the pointee type is a guess, so it gets no TBAA tag to be wrong about
     return builder->CreateLoad(i32(), ptr);
 }
 
@@ -279,11 +386,53 @@ llvm::Value* AeroIR::load(llvm::Value* ptr, llvm::Type* elementType) {
         return ptr;
     }
     
-    return builder->CreateLoad(elementType, ptr);
+    llvm::LoadInst* loadInst = builder->CreateLoad(elementType, ptr);
+    if (llvm::MDNode* tag = tbaaTag(elementType)) {
+        loadInst->setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+    }
+    return loadInst;
 }
 
-void AeroIR::store(llvm::Value* val, llvm::Value* ptr) {
-    builder->CreateStore(val, ptr);
+llvm::StoreInst* AeroIR::store(llvm::Value* val, llvm::Value* ptr) {
+    llvm::StoreInst* storeInst = builder->CreateStore(val, ptr);
+    if (llvm::MDNode* tag = tbaaTag(val->getType())) {
+        storeInst->setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+    }
+    return storeInst;
+}
+
+// Vexar's scalar types never alias each other; char accesses alias everything,
+// as strings and raw buffers are walked bytewise
+llvm::MDNode* AeroIR::tbaaTag(llvm::Type* type) {
+    if (!strictAliasing) return nullptr;
+
+    std::string name;
+    if (type->isIntegerTy(1)) name = "bool";
+    else if (type->isIntegerTy(8)) name = "omnipotent char";
+    else if (type->isIntegerTy(16)) name = "short";
+    else if (type->isIntegerTy(32)) name = "int";
+    else if (type->isIntegerTy(64)) name = "long";
+    else if (type->isFloatTy()) name = "float";
+    else if (type->isDoubleTy()) name = "double";
+    else if (type->isPointerTy()) name = "any pointer";
+    else return nullptr;
+
+    auto it = tbaaTags.find(name);
+    if (it != tbaaTags.end()) return it->second;
+
+    llvm::MDBuilder mdBuilder(*context);
+    if (!tbaaRoot) {
+        tbaaRoot = mdBuilder.createTBAARoot("Vexar TBAA");
+    }
+    llvm::MDNode* charNode = mdBuilder.createTBAAScalarTypeNode("omnipotent char", tbaaRoot);
+    llvm::MDNode* typeNode = name == "omnipotent char" ? charNode : mdBuilder.createTBAAScalarTypeNode(name, charNode);
+    llvm::MDNode* tag = mdBuilder.createTBAAStructTagNode(typeNode, typeNode, 0);
+    tbaaTags[name] = tag;
+    return tag;
+}
+
+void AeroIR::setStrictAliasing(bool enabled) {
+    strictAliasing = enabled;
 }
 
 void AeroIR::store(llvm::Value* val, const std::string& name) {
@@ -296,13 +445,25 @@ llvm::Value* AeroIR::stackArray(const std::string& name, llvm::Type* elemType, i
     return var(name, arrayType);
 }
 
-llvm::Value* AeroIR::heapArray(const std::string& name, llvm::Type* elemType, llvm::Value* size) {
+llvm::Value* AeroIR::heapArray(const std::string& name, llvm::Type* elemType, llvm::Value* size, unsigned alignment) {
     llvm::DataLayout DL = module->getDataLayout();
     uint64_t elemSize = DL.getTypeAllocSize(elemType);
     llvm::Value* totalSize = mul(size, constI64(elemSize));
-    llvm::Value* ptr = builder->CreateCall(mallocFunc, {totalSize});
-    gcPointers.insert(ptr);
+    llvm::Value* ptr = nullptr;
+    llvm::Function* deallocator = freeFunc;
+    if (alignment > 16 && module->getTargetTriple().isOSWindows()) {
+        ptr = builder->CreateCall(runtimeFunction("_aligned_malloc"), {totalSize, constI64(alignment)});
+        deallocator = runtimeFunction("_aligned_free");
+    } else if (alignment > 16) {
+        // aligned_alloc wants the size rounded up to a multiple of the alignment
+        llvm::Value* rounded = builder->CreateAnd(add(totalSize, constI64(alignment - 1)), constI64(~static_cast<long>(alignment - 1)));
+        ptr = builder->CreateCall(runtimeFunction("aligned_alloc"), {constI64(alignment), rounded});
+    } else {
+        ptr = builder->CreateCall(mallocFunc, {totalSize});
+    }
+    gcPointers[ptr] = deallocator;
     setVar(name, ptr);
+    setArrayElementType(ptr, elemType);
     return ptr;
 }
 
@@ -312,11 +473,29 @@ llvm::Value* AeroIR::arrayAccess(llvm::Value* arrayPtr, llvm::Value* index) {
     if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(arrayPtr)) {
         llvm::Type* allocatedType = alloca->getAllocatedType();
         if (allocatedType->isArrayTy()) {
-            return builder->CreateInBoundsGEP(allocatedType, arrayPtr, {constI32(0), index});
+            return elementPtr(allocatedType, arrayPtr, {constI64(0), index});
         }
     }
     
-    return builder->CreateInBoundsGEP(i8(), arrayPtr, index);
+    return elementPtr(i8(), arrayPtr, {index});
+}
+
+// indices are sign-extended to pointer width up front so loops index with a
+// single widened induction variable instead of a sext per access
+llvm::Value* AeroIR::toIndex(llvm::Value* index) {
+    llvm::Type* indexType = module->getDataLayout().getIndexType(*context, 0);
+    if (!index->getType()->isIntegerTy() || index->getType() == indexType) return index;
+    if (index->getType()->getIntegerBitWidth() > indexType->getIntegerBitWidth()) {
+        return builder->CreateTrunc(index, indexType);
+    }
+    return index->getType()->isIntegerTy(1) ? builder->CreateZExt(index, indexType) : builder->CreateSExt(index, indexType);
+}
+
+llvm::Value* AeroIR::elementPtr(llvm::Type* type, llvm::Value* ptr, std::vector<llvm::Value*> indices) {
+    for (auto& index : indices) {
+        index = toIndex(index);
+    }
+    return builder->CreateInBoundsGEP(type, ptr, indices);
 }
 
 llvm::Value* AeroIR::arrayAccess(const std::string& arrayName, llvm::Value* index) {
@@ -324,18 +503,40 @@ llvm::Value* AeroIR::arrayAccess(const std::string& arrayName, llvm::Value* inde
     return arrayPtr ? arrayAccess(arrayPtr, index) : nullptr;
 }
 
+// pointers carry no element type, so arrays reached through one (heap arrays,
+// `T[]` parameters and variables) record their declared element type here
+void AeroIR::setArrayElementType(llvm::Value* array, llvm::Type* elemType) {
+    arrayElementTypes[array] = elemType;
+}
+
+llvm::Type* AeroIR::getArrayElementType(llvm::Value* array) {
+    auto it = arrayElementTypes.find(array);
+    return it != arrayElementTypes.end() ? it->second : nullptr;
+}
+
+// the address a pointer-backed array variable points at; `elemType` is null
+// when the element type is unknown, as for strings
+llvm::Value* AeroIR::pointerArrayBase(llvm::Value* array, llvm::Type*& elemType) {
+    elemType = getArrayElementType(array);
+    if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(array)) {
+        return alloca->getAllocatedType()->isPointerTy() ? load(alloca) : nullptr;
+    }
+    return array->getType()->isPointerTy() ? array : nullptr;
+}
+
 llvm::Value* AeroIR::malloc(llvm::Type* type, llvm::Value* count) {
     llvm::DataLayout DL = module->getDataLayout();
     uint64_t elemSize = DL.getTypeAllocSize(type);
     llvm::Value* size = constI64(elemSize);
     if (count) size = mul(size, count);
     llvm::Value* ptr = builder->CreateCall(mallocFunc, {size});
-    gcPointers.insert(ptr);
+    gcPointers[ptr] = freeFunc;
     return ptr;
 }
 
 void AeroIR::free(llvm::Value* ptr) {
-    builder->CreateCall(freeFunc, {ptr});
+    auto it = gcPointers.find(ptr);
+    builder->CreateCall(it != gcPointers.end() ? it->second : freeFunc, {ptr});
     gcPointers.erase(ptr);
 }
 
@@ -343,19 +544,89 @@ void AeroIR::gcCleanup() {
     builder->CreateCall(gcCleanupFunc);
 }
 
+// signed overflow is undefined unless --wrapping is given, so integer ops carry nsw
 llvm::Value* AeroIR::add(llvm::Value* lhs, llvm::Value* rhs) {
-    return lhs->getType()->isIntegerTy() ? 
-           builder->CreateAdd(lhs, rhs) : builder->CreateFAdd(lhs, rhs);
+    if (lhs->getType()->isIntegerTy()) {
+        return builder->CreateAdd(lhs, rhs, "", false, noSignedWrap(lhs->getType()));
+    }
+    llvm::Value* fused = contractMulAdd(lhs, rhs, false);
+    return fused ? fused : builder->CreateFAdd(lhs, rhs);
 }
 
 llvm::Value* AeroIR::sub(llvm::Value* lhs, llvm::Value* rhs) {
-    return lhs->getType()->isIntegerTy() ? 
-           builder->CreateSub(lhs, rhs) : builder->CreateFSub(lhs, rhs);
+    if (lhs->getType()->isIntegerTy()) {
+        return builder->CreateSub(lhs, rhs, "", false, noSignedWrap(lhs->getType()));
+    }
+    llvm::Value* fused = contractMulAdd(lhs, rhs, true);
+    return fused ? fused : builder->CreateFSub(lhs, rhs);
+}
+
+// -ffp-contract=on: a multiply feeding an add within one expression becomes llvm.fmuladd,
+// which the backend fuses only where the target has FMA; values from other statements
+// come back through a load, so contraction never crosses a statement
+llvm::Value* AeroIR::contractMulAdd(llvm::Value* lhs, llvm::Value* rhs, bool subtract) {
+    if (!fpContraction || builder->getFastMathFlags().allowContract()) {
+        return nullptr;
+    }
+    auto unusedMul = [this](llvm::Value* v) -> llvm::BinaryOperator* {
+        auto* mulInst = llvm::dyn_cast<llvm::BinaryOperator>(v);
+        if (!mulInst || mulInst->getOpcode() != llvm::Instruction::FMul || !mulInst->use_empty() ||
+            mulInst->getParent() != builder->GetInsertBlock()) {
+            return nullptr;
+        }
+        return mulInst;
+    };
+
+    llvm::Value* a;
+    llvm::Value* b;
+    llvm::Value* c;
+    llvm::BinaryOperator* mulInst = unusedMul(lhs);
+    if (mulInst) {
+        // a*b + c, a*b - c
+        a = mulInst->getOperand(0);
+        b = mulInst->getOperand(1);
+        c = subtract ? builder->CreateFNeg(rhs) : rhs;
+    } else if ((mulInst = unusedMul(rhs))) {
+        // c + a*b, c - a*b
+        a = subtract ? builder->CreateFNeg(mulInst->getOperand(0)) : mulInst->getOperand(0);
+        b = mulInst->getOperand(1);
+        c = lhs;
+    } else {
+        return nullptr;
+    }
+
+    llvm::Value* fused = builder->CreateIntrinsic(llvm::Intrinsic::fmuladd, {lhs->getType()}, {a, b, c});
+    mulInst->eraseFromParent();
+    return fused;
 }
 
 llvm::Value* AeroIR::mul(llvm::Value* lhs, llvm::Value* rhs) {
     return lhs->getType()->isIntegerTy() ? 
-           builder->CreateMul(lhs, rhs) : builder->CreateFMul(lhs, rhs);
+           builder->CreateMul(lhs, rhs, "", false, noSignedWrap(lhs->getType())) : builder->CreateFMul(lhs, rhs);
+}
+
+llvm::Value* AeroIR::wrappingAdd(llvm::Value* lhs, llvm::Value* rhs) {
+    return builder->CreateAdd(lhs, rhs);
+}
+
+llvm::Value* AeroIR::wrappingSub(llvm::Value* lhs, llvm::Value* rhs) {
+    return builder->CreateSub(lhs, rhs);
+}
+
+llvm::Value* AeroIR::wrappingMul(llvm::Value* lhs, llvm::Value* rhs) {
+    return builder->CreateMul(lhs, rhs);
+}
+
+bool AeroIR::noSignedWrap(llvm::Type* type) const {
+    return !wrappingArithmetic && !type->isIntegerTy(1);
+}
+
+void AeroIR::setWrappingArithmetic(bool enabled) {
+    wrappingArithmetic = enabled;
+}
+
+void AeroIR::setFPContraction(bool enabled) {
+    fpContraction = enabled;
 }
 
 llvm::Value* AeroIR::div(llvm::Value* lhs, llvm::Value* rhs) {
@@ -369,7 +640,7 @@ llvm::Value* AeroIR::mod(llvm::Value* lhs, llvm::Value* rhs) {
 
 llvm::Value* AeroIR::neg(llvm::Value* val) {
     return val->getType()->isIntegerTy() ? 
-           builder->CreateNeg(val) : builder->CreateFNeg(val);
+           builder->CreateNeg(val, "", noSignedWrap(val->getType())) : builder->CreateFNeg(val);
 }
 
 llvm::Value* AeroIR::eq(llvm::Value* lhs, llvm::Value* rhs) {
@@ -491,8 +762,14 @@ llvm::Value* AeroIR::branch(llvm::BasicBlock* dest) {
     return builder->CreateBr(dest);
 }
 
-llvm::Value* AeroIR::condBranch(llvm::Value* cond, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock) {
-    return builder->CreateCondBr(cond, trueBlock, falseBlock);
+// likelihood > 0 marks the true edge as hot, < 0 as cold
+llvm::Value* AeroIR::condBranch(llvm::Value* cond, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock, int likelihood) {
+    llvm::MDNode* weights = nullptr;
+    if (likelihood != 0) {
+        llvm::MDBuilder mdBuilder(*context);
+        weights = likelihood > 0 ? mdBuilder.createLikelyBranchWeights() : mdBuilder.createUnlikelyBranchWeights();
+    }
+    return builder->CreateCondBr(cond, trueBlock, falseBlock, weights);
 }
 
 llvm::BasicBlock* AeroIR::createWhileLoop(llvm::Value* condition, llvm::BasicBlock* body, llvm::BasicBlock* afterLoop) {
@@ -544,6 +821,62 @@ llvm::Function* AeroIR::getRegisteredBuiltin(const std::string& name) {
     return builtinFuncs.count(name) ? builtinFuncs[name] : nullptr;
 }
 
+void AeroIR::enableSourceLocations(const std::string& fileName, const std::string& directory) {
+    if (diBuilder) return;
+    module->addModuleFlag(llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+    diBuilder = std::make_unique<llvm::DIBuilder>(*module);
+    diFile = diBuilder->createFile(fileName, directory);
+    diCompileUnit = diBuilder->createCompileUnit(llvm::dwarf::DW_LANG_C, diFile, "vexar", false, "", 0, "",
+                                                 llvm::DICompileUnit::DebugEmissionKind::NoDebug);
+}
+
+void AeroIR::setSourceLocation(unsigned line, unsigned column) {
+    if (!diBuilder) return;
+    llvm::BasicBlock* block = builder->GetInsertBlock();
+    llvm::DISubprogram* sp = block ? block->getParent()->getSubprogram() : nullptr;
+    if (!sp) {
+        builder->SetCurrentDebugLocation(llvm::DebugLoc());
+        return;
+    }
+    builder->SetCurrentDebugLocation(llvm::DILocation::get(*context, line, column, sp));
+}
+
+void AeroIR::finalizeSourceLocations() {
+    if (diBuilder) diBuilder->finalize();
+}
+
+void AeroIR::setTarget(llvm::TargetMachine* targetMachine) {
+    module->setTargetTriple(targetMachine->getTargetTriple());
+    module->setDataLayout(targetMachine->createDataLayout());
+    targetCPU = targetMachine->getTargetCPU().str();
+    targetFeatures = targetMachine->getTargetFeatureString().str();
+    if (targetCPU == "generic") targetCPU.clear();
+
+    for (auto& func : *module) {
+        if (func.isDeclaration()) continue;
+        if (!targetCPU.empty()) func.addFnAttr("target-cpu", targetCPU);
+        if (!targetFeatures.empty()) func.addFnAttr("target-features", targetFeatures);
+    }
+}
+
+void AeroIR::setDefaultFastMath(llvm::FastMathFlags flags) {
+    builder->setFastMathFlags(flags);
+}
+
+// scoped flags only ever add to what the enclosing scope already allows
+void AeroIR::pushFastMath(llvm::FastMathFlags flags) {
+    llvm::FastMathFlags current = builder->getFastMathFlags();
+    fastMathStack.push_back(current);
+    current |= flags;
+    builder->setFastMathFlags(current);
+}
+
+void AeroIR::popFastMath() {
+    if (fastMathStack.empty()) return;
+    builder->setFastMathFlags(fastMathStack.back());
+    fastMathStack.pop_back();
+}
+
 void AeroIR::print() {
     module->print(llvm::outs(), nullptr);
 }
@@ -24,6 +24,9 @@
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/MDBuilder.h>
 
 #include <llvm/Support/InitLLVM.h>
 #include <llvm/Support/TargetSelect.h>
@@ -71,13 +74,29 @@ private:
     std::stack<std::unordered_map<std::string, llvm::Value*>> scopes;
     std::unordered_map<std::string, CustomType> customTypes;
     std::unordered_map<std::string, llvm::Function*> builtinFuncs;
-    std::set<llvm::Value*> gcPointers;
+    // heap pointers and the function that releases each one
+    std::unordered_map<llvm::Value*, llvm::Function*> gcPointers;
     llvm::Function* currentFunction;
     llvm::Function* mallocFunc;
     llvm::Function* freeFunc;
     llvm::Function* gcCleanupFunc;
+    std::unique_ptr<llvm::DIBuilder> diBuilder;
+    llvm::DICompileUnit* diCompileUnit;
+    llvm::DIFile* diFile;
+    std::string targetCPU;
+    std::string targetFeatures;
+    std::vector<llvm::FastMathFlags> fastMathStack;
+    bool wrappingArithmetic = false;
+    bool strictAliasing = true;
+    bool fpContraction = false;
+    llvm::MDNode* tbaaRoot = nullptr;
+    std::unordered_map<std::string, llvm::MDNode*> tbaaTags;
+    std::unordered_map<llvm::Value*, llvm::Type*> arrayElementTypes;
     
     void setupBuiltins();
+    bool noSignedWrap(llvm::Type* type) const;
+    llvm::Value* contractMulAdd(llvm::Value* lhs, llvm::Value* rhs, bool subtract);
+    llvm::MDNode* tbaaTag(llvm::Type* type);
     
 public:
     AeroIR(const std::string& moduleName);
@@ -130,10 +149,11 @@ public:
     llvm::Value* constString(const std::string& str);
     
     llvm::Function* createFunction(const std::string& name, llvm::Type* retType, 
-                                   const std::vector<llvm::Type*>& paramTypes);
+                                   const std::vector<llvm::Type*>& paramTypes, unsigned line = 0);
     llvm::Function* createBuiltinFunction(const std::string& name, llvm::Type* retType,
                                           const std::vector<llvm::Type*>& paramTypes);
     llvm::Function* getBuiltinFunction(const std::string& name);
+    llvm::Function* runtimeFunction(const std::string& name);
     void endFunction();
     llvm::Value* ret(llvm::Value* val = nullptr);
     
@@ -150,13 +170,18 @@ public:
     llvm::Value* load(llvm::Value* ptr);
     llvm::Value* load(llvm::Value* ptr, llvm::Type* elementType);
     llvm::Value* load(const std::string& name);
-    void store(llvm::Value* val, llvm::Value* ptr);
+    llvm::StoreInst* store(llvm::Value* val, llvm::Value* ptr);
     void store(llvm::Value* val, const std::string& name);
     
     llvm::Value* stackArray(const std::string& name, llvm::Type* elemType, int size);
-    llvm::Value* heapArray(const std::string& name, llvm::Type* elemType, llvm::Value* size);
+    llvm::Value* heapArray(const std::string& name, llvm::Type* elemType, llvm::Value* size, unsigned alignment = 0);
     llvm::Value* arrayAccess(llvm::Value* arrayPtr, llvm::Value* index);
+    llvm::Value* elementPtr(llvm::Type* type, llvm::Value* ptr, std::vector<llvm::Value*> indices);
+    llvm::Value* toIndex(llvm::Value* index);
     llvm::Value* arrayAccess(const std::string& arrayName, llvm::Value* index);
+    void setArrayElementType(llvm::Value* array, llvm::Type* elemType);
+    llvm::Type* getArrayElementType(llvm::Value* array);
+    llvm::Value* pointerArrayBase(llvm::Value* array, llvm::Type*& elemType);
     
     llvm::Value* malloc(llvm::Type* type, llvm::Value* count = nullptr);
     void free(llvm::Value* ptr);
@@ -168,6 +193,12 @@ public:
     llvm::Value* div(llvm::Value* lhs, llvm::Value* rhs);
     llvm::Value* mod(llvm::Value* lhs, llvm::Value* rhs);
     llvm::Value* neg(llvm::Value* val);
+    llvm::Value* wrappingAdd(llvm::Value* lhs, llvm::Value* rhs);
+    llvm::Value* wrappingSub(llvm::Value* lhs, llvm::Value* rhs);
+    llvm::Value* wrappingMul(llvm::Value* lhs, llvm::Value* rhs);
+    void setWrappingArithmetic(bool enabled);
+    void setStrictAliasing(bool enabled);
+    void setFPContraction(bool enabled);
     
     llvm::Value* eq(llvm::Value* lhs, llvm::Value* rhs);
     llvm::Value* ne(llvm::Value* lhs, llvm::Value* rhs);
@@ -198,7 +229,7 @@ public:
     llvm::BasicBlock* createBlock(const std::string& name);
     void setInsertPoint(llvm::BasicBlock* block);
     llvm::Value* branch(llvm::BasicBlock* dest);
-    llvm::Value* condBranch(llvm::Value* cond, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock);
+    llvm::Value* condBranch(llvm::Value* cond, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock, int likelihood = 0);
     
     llvm::BasicBlock* createWhileLoop(llvm::Value* condition, llvm::BasicBlock* body, llvm::BasicBlock* afterLoop = nullptr);
     llvm::BasicBlock* createForLoop(llvm::Value* init, llvm::Value* condition, llvm::Value* increment, 
@@ -210,6 +241,16 @@ public:
     void registerBuiltin(const std::string& name, llvm::Type* retType, const std::vector<llvm::Type*>& paramTypes);
     llvm::Function* getRegisteredBuiltin(const std::string& name);
     
+    void enableSourceLocations(const std::string& fileName, const std::string& directory);
+    void setSourceLocation(unsigned line, unsigned column);
+    void finalizeSourceLocations();
+
+    void setTarget(llvm::TargetMachine* targetMachine);
+
+    void setDefaultFastMath(llvm::FastMathFlags flags);
+    void pushFastMath(llvm::FastMathFlags flags);
+    void popFastMath();
+    
     void print();
     bool verify();
     
@@ -3,26 +3,631 @@
 
 #include "../../MiddleEnd/AST.hh"
 #include "Gens/FunctionGenerator.hh"
+#include "Gens/InlineLanguageGenerator.hh"
 
 #include "PlatformBinary.hh"
+#include "../../Miscellaneous/conf/TargetMap.hh"
 
 Generator::Generator(GL_ASTPackage& pkg) {
     llvm::InitializeAllTargets();
     llvm::InitializeAllAsmPrinters();
     llvm::InitializeAllTargetMCs();
+    llvm::InitializeAllDisassemblers();
 
     this->ASTPkg.InputFile = pkg.InputFile;
     this->ASTPkg.OutputFile = pkg.OutputFile;
     this->ASTPkg.Optimisation = pkg.Optimisation;
+    this->ASTPkg.FastCompile = pkg.FastCompile;
+    this->ASTPkg.InlineThreshold = pkg.InlineThreshold;
+    this->ASTPkg.InlineRounds = pkg.InlineRounds;
+    this->ASTPkg.Unroll = pkg.Unroll;
+    this->ASTPkg.Vectorize = pkg.Vectorize;
+    this->ASTPkg.SLPVectorize = pkg.SLPVectorize;
     this->ASTPkg.Verbose = pkg.Verbose;
     this->ASTPkg.Debug = pkg.Debug;
     this->ASTPkg.RunAfterCompile = pkg.RunAfterCompile;
     this->ASTPkg.CompilerTarget = pkg.CompilerTarget;
+    this->ASTPkg.TargetCPU = pkg.TargetCPU;
+    this->ASTPkg.TargetFeatures = pkg.TargetFeatures;
+    this->ASTPkg.Remarks = pkg.Remarks;
+    this->ASTPkg.RemarksFile = pkg.RemarksFile;
+    this->ASTPkg.RemarksFilter = pkg.RemarksFilter;
+    this->ASTPkg.ProfileGenerate = pkg.ProfileGenerate;
+    this->ASTPkg.ProfileGenerateFile = pkg.ProfileGenerateFile;
+    this->ASTPkg.ProfileUseFile = pkg.ProfileUseFile;
+    this->ASTPkg.ThinLTO = pkg.ThinLTO;
+    this->ASTPkg.FastMath = pkg.FastMath;
+    this->ASTPkg.Wrapping = pkg.Wrapping;
+    this->ASTPkg.StrictAliasing = pkg.StrictAliasing;
+    this->ASTPkg.FPContract = pkg.FPContract;
+    this->ASTPkg.VectorLibrary = pkg.VectorLibrary;
+    this->ASTPkg.LinkInputs = pkg.LinkInputs;
 
     this->CInstance.ASTRoot = std::move(pkg.ASTRoot);
 
     const std::string LLVM_MODULE_NAME = this->ASTPkg.InputFile.stem().string() + ".vexar";
     this->CInstance.IR = std::make_unique<AeroIR>(LLVM_MODULE_NAME);
+
+    CreateTargetMachine();
+    if (this->CInstance.TargetMachine) {
+        this->CInstance.IR->setTarget(this->CInstance.TargetMachine.get());
+    }
+
+    llvm::FastMathFlags DefaultFMF;
+    if (this->ASTPkg.FastMath) {
+        DefaultFMF.setFast();
+    }
+    if (this->ASTPkg.FPContract == "fast") {
+        DefaultFMF.setAllowContract(true);
+    } else if (this->ASTPkg.FPContract == "off") {
+        DefaultFMF.setAllowContract(false);
+    }
+    this->CInstance.IR->setDefaultFastMath(DefaultFMF);
+    this->CInstance.IR->setFPContraction(this->ASTPkg.FPContract != "off");
+    this->CInstance.IR->setWrappingArithmetic(this->ASTPkg.Wrapping);
+    this->CInstance.IR->setStrictAliasing(this->ASTPkg.StrictAliasing);
+
+    // inline C/C++ stays a separate unit only when we link; other outputs must be self-contained,
+    // and lli never loads the extra bitcode
+    InlineThinLTO = this->ASTPkg.ThinLTO && !this->ASTPkg.RunAfterCompile && this->ASTPkg.CompilerTarget != "interpret" && ProducesExecutable();
+
+    if (this->ASTPkg.Remarks || !this->ASTPkg.RemarksFile.empty()) {
+        this->CInstance.IR->enableSourceLocations(this->ASTPkg.InputFile.filename().string(), this->ASTPkg.InputFile.parent_path().string());
+    }
+}
+
+Generator::~Generator() {
+    RemoveInlineBitcodeFiles();
+}
+
+void Generator::CreateTargetMachine() {
+    std::string Triple = this->ASTPkg.CompilerTarget;
+    if (target_map.find(Triple) != target_map.end()) {
+        Triple = target_map[Triple];
+    }
+
+    // output-only targets still need a real triple to optimise against
+    static const std::map<std::string, std::string> AsmTriples = {
+        {"asm-arm", "arm"}, {"asm-arm64", "aarch64"}, {"asm-riscv64", "riscv64"},
+        {"asm-wasm", "wasm32"}, {"asm-ptx", "nvptx64"}
+    };
+    if (AsmTriples.find(Triple) != AsmTriples.end()) {
+        Triple = AsmTriples.at(Triple);
+    }
+
+    std::string Error;
+    if (Triple.empty() || !llvm::TargetRegistry::lookupTarget(Triple, Error)) {
+        Triple = llvm::sys::getDefaultTargetTriple();
+    }
+
+    const llvm::Target* Target = llvm::TargetRegistry::lookupTarget(Triple, Error);
+    if (!Target) {
+        Write("Code Generation", "No LLVM target for " + Triple + ", optimising without a cost model: " + Error, 1, true, true, "");
+        return;
+    }
+
+    std::string CPU = this->ASTPkg.TargetCPU;
+    std::string Features = this->ASTPkg.TargetFeatures;
+
+    if (CPU == "native") {
+        if (Triple != llvm::sys::getDefaultTargetTriple()) {
+            Write("Code Generation", "-march=native ignored when cross-compiling for " + Triple, 1, true, true, "");
+            CPU.clear();
+        } else {
+            CPU = llvm::sys::getHostCPUName().str();
+            std::string HostFeatures;
+            for (const auto& Feature : llvm::sys::getHostCPUFeatures()) {
+                HostFeatures += (HostFeatures.empty() ? "" : ",") + std::string(Feature.second ? "+" : "-") + Feature.first().str();
+            }
+            Features = Features.empty() ? HostFeatures : HostFeatures + "," + Features;
+        }
+    }
+
+    if (CPU.empty()) {
+        CPU = "generic";
+    }
+
+    llvm::CodeGenOptLevel CodeGenLevel = llvm::CodeGenOptLevel::Default;
+    if (this->ASTPkg.Optimisation == 0 || this->ASTPkg.FastCompile) {
+        CodeGenLevel = llvm::CodeGenOptLevel::None;
+    } else if (this->ASTPkg.Optimisation == 3) {
+        CodeGenLevel = llvm::CodeGenOptLevel::Aggressive;
+    }
+
+    llvm::TargetOptions Options;
+    if (this->ASTPkg.FPContract == "off") {
+        Options.AllowFPOpFusion = llvm::FPOpFusion::Strict;
+    } else if (this->ASTPkg.FastMath || this->ASTPkg.FPContract == "fast") {
+        Options.AllowFPOpFusion = llvm::FPOpFusion::Fast;
+    }
+    // -Og: skip SelectionDAG; AArch64 has GlobalISel at -O0, everything else gets FastISel,
+    // and either falls back to the DAG for whatever it cannot select
+    if (this->ASTPkg.FastCompile) {
+        if (llvm::Triple(Triple).isAArch64()) {
+            Options.EnableGlobalISel = true;
+            Options.GlobalISelAbort = llvm::GlobalISelAbortMode::Disable;
+        } else {
+            Options.EnableFastISel = true;
+        }
+    }
+    this->CInstance.TargetMachine.reset(Target->createTargetMachine(llvm::Triple(Triple), CPU, Features, Options, std::nullopt, std::nullopt, CodeGenLevel));
+
+    if (this->ASTPkg.Verbose && this->CInstance.TargetMachine) {
+        Write("Code Generation", "Target " + Triple + " (cpu: " + CPU + (Features.empty() ? "" : ", features: " + Features) + ")", 0, true, true, "");
+    }
+}
+
+bool Generator::ProducesExecutable() const {
+    static const std::set<std::string> UnlinkedTargets = {
+        "llvm", "bitcode", "obj", "asm", "asm-intel", "asm-att", "asm-arm", "asm-arm64", "asm-riscv64", "asm-wasm", "asm-ptx"
+    };
+    return UnlinkedTargets.count(this->ASTPkg.CompilerTarget) == 0;
+}
+
+// SVML ships with Intel's oneAPI compilers rather than any libc, so it is only
+// linkable when the toolchain's library search path (LIB for MSVC) reaches it
+static fs::path FindSvmlLibrary(const llvm::Triple& Triple) {
+    const char* SearchPath = std::getenv(Triple.isWindowsMSVCEnvironment() ? "LIB" : "LIBRARY_PATH");
+    if (!SearchPath) {
+        return {};
+    }
+    std::vector<std::string> Names = Triple.isWindowsMSVCEnvironment()
+        ? std::vector<std::string>{"svml_dispmd.lib"} : std::vector<std::string>{"libsvml.so", "libsvml.a"};
+
+    llvm::SmallVector<llvm::StringRef, 8> Directories;
+    llvm::StringRef(SearchPath).split(Directories, llvm::sys::EnvPathSeparator, -1, false);
+    for (llvm::StringRef Directory : Directories) {
+        for (const auto& Name : Names) {
+            fs::path Candidate = fs::path(Directory.str()) / Name;
+            std::error_code Error;
+            if (fs::is_regular_file(Candidate, Error)) {
+                return Candidate;
+            }
+        }
+    }
+    return {};
+}
+
+llvm::TargetLibraryInfoImpl::VectorLibrary Generator::ResolveVectorLibrary() const {
+    using TLII = llvm::TargetLibraryInfoImpl;
+    static const std::map<std::string, TLII::VectorLibrary> Named = {
+        {"none", TLII::NoLibrary}, {"libmvec", TLII::LIBMVEC}, {"svml", TLII::SVML}, {"sleef", TLII::SLEEFGNUABI},
+        {"armpl", TLII::ArmPL}, {"accelerate", TLII::Accelerate}, {"darwin_libsystem_m", TLII::DarwinLibSystemM}, {"amdlibm", TLII::AMDLIBM}
+    };
+    const llvm::Triple& Triple = this->CInstance.IR->getModule()->getTargetTriple();
+    auto It = Named.find(this->ASTPkg.VectorLibrary);
+    if (It != Named.end()) {
+        // every vectorized call would be an unresolved __svml_* symbol at link time
+        if (It->second == TLII::SVML && ProducesExecutable() && FindSvmlLibrary(Triple).empty()) {
+            Write("Code Generation", std::string("-fveclib=svml needs Intel's SVML library, but ") +
+                  (Triple.isWindowsMSVCEnvironment() ? "svml_dispmd.lib is not on LIB" : "libsvml is not on LIBRARY_PATH"), 2, true, true, "");
+        }
+        return It->second;
+    }
+
+    // auto: only libraries that ship with the target's libc, and never under lli, which may not load them
+    if (this->ASTPkg.RunAfterCompile || this->ASTPkg.CompilerTarget == "interpret") {
+        return TLII::NoLibrary;
+    }
+    if (Triple.isOSLinux() && Triple.isGNUEnvironment() && (Triple.getArch() == llvm::Triple::x86_64 || Triple.getArch() == llvm::Triple::aarch64)) {
+        return TLII::LIBMVEC;
+    }
+    if (Triple.isOSDarwin()) {
+        return TLII::DarwinLibSystemM;
+    }
+    // the MSVC CRT has no vector math entry points LLVM can target; SVML is used when installed
+    if (Triple.isWindowsMSVCEnvironment() && Triple.getArch() == llvm::Triple::x86_64 && ProducesExecutable() && !FindSvmlLibrary(Triple).empty()) {
+        return TLII::SVML;
+    }
+    return TLII::NoLibrary;
+}
+
+void Generator::InternalizeSymbols(const std::set<std::string>& Exported) {
+    llvm::Module* Module = this->GetModulePtr();
+
+    // musttail needs caller and callee on the same convention, so both ends keep the C one
+    std::set<llvm::Function*> MustTailLinked;
+    for (auto& Function : *Module) {
+        for (auto& Block : Function) {
+            for (auto& Inst : Block) {
+                auto* Call = llvm::dyn_cast<llvm::CallInst>(&Inst);
+                if (Call && Call->isMustTailCall()) {
+                    MustTailLinked.insert(&Function);
+                    MustTailLinked.insert(Call->getCalledFunction());
+                }
+            }
+        }
+    }
+
+    for (auto& Function : *Module) {
+        if (Function.isDeclaration() || Function.getName() == "main" || Exported.count(Function.getName().str())) {
+            continue;
+        }
+        Function.setLinkage(llvm::GlobalValue::InternalLinkage);
+
+        // fastcc is only safe when every use is a direct call we can retag
+        if (Function.hasAddressTaken() || Function.isVarArg() || MustTailLinked.count(&Function)) {
+            continue;
+        }
+        Function.setCallingConv(llvm::CallingConv::Fast);
+        for (llvm::User* User : Function.users()) {
+            if (auto* Call = llvm::dyn_cast<llvm::CallBase>(User)) {
+                Call->setCallingConv(llvm::CallingConv::Fast);
+            }
+        }
+    }
+
+    for (auto& Global : Module->globals()) {
+        if (!Global.isDeclaration() && Global.hasExternalLinkage()) {
+            Global.setLinkage(llvm::GlobalValue::InternalLinkage);
+        }
+    }
+
+    for (auto& IFunc : Module->ifuncs()) {
+        if (!Exported.count(IFunc.getName().str())) {
+            IFunc.setLinkage(llvm::GlobalValue::InternalLinkage);
+        }
+    }
+}
+
+// @flatten: inline every call in the body, including the calls that inlining exposes
+void Generator::FlattenFunctions(const std::vector<llvm::Function*>& Flattened) {
+    const unsigned MaxInstructions = 20000;
+
+    for (llvm::Function* Function : Flattened) {
+        std::vector<llvm::CallBase*> Worklist;
+        for (auto& Block : *Function) {
+            for (auto& Inst : Block) {
+                if (auto* Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
+                    Worklist.push_back(Call);
+                }
+            }
+        }
+
+        while (!Worklist.empty()) {
+            llvm::CallBase* Call = Worklist.back();
+            Worklist.pop_back();
+
+            llvm::Function* Callee = Call->getCalledFunction();
+            if (!Callee || Callee->isDeclaration() || Callee == Function || Callee->isVarArg() ||
+                Callee->hasFnAttribute(llvm::Attribute::NoInline)) {
+                continue;
+            }
+            if (Function->getInstructionCount() > MaxInstructions) {
+                Write("Code Generation", "Stopped flattening " + Function->getName().str() + ": body exceeds " +
+                      std::to_string(MaxInstructions) + " instructions", 1, true, true, "");
+                break;
+            }
+
+            llvm::InlineFunctionInfo IFI;
+            if (llvm::InlineFunction(*Call, IFI).isSuccess()) {
+                for (llvm::CallBase* Inlined : IFI.InlinedCallSites) {
+                    Worklist.push_back(Inlined);
+                }
+            }
+        }
+    }
+}
+
+// feature name -> dispatch priority, as understood by the compiler-rt/libgcc __cpu_model tables
+static const std::map<std::string, unsigned> CloneFeatures = {
+#define X86_FEATURE_COMPAT(ENUM, STR, PRIORITY) {STR, PRIORITY},
+#include "llvm/TargetParser/X86TargetParser.def"
+};
+
+// ptr @f.resolver(): probe the CPU once and hand back the best variant it supports
+llvm::Function* Generator::CreateCloneResolver(llvm::Function* Default, const std::vector<std::pair<std::string, llvm::Function*>>& Variants) {
+    llvm::Module* Module = this->GetModulePtr();
+    llvm::LLVMContext& Context = Module->getContext();
+    llvm::Type* Int32 = llvm::Type::getInt32Ty(Context);
+    llvm::Type* Ptr = llvm::PointerType::getUnqual(Context);
+
+    auto* Resolver = llvm::Function::Create(llvm::FunctionType::get(Ptr, false), llvm::GlobalValue::InternalLinkage,
+                                            Default->getName().drop_back(std::strlen(".default")) + ".resolver", Module);
+    llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(Context, "entry", Resolver));
+
+    llvm::FunctionCallee Init = Module->getOrInsertFunction("__cpu_indicator_init", llvm::FunctionType::get(llvm::Type::getVoidTy(Context), false));
+    if (auto* InitFunc = llvm::dyn_cast<llvm::Function>(Init.getCallee())) {
+        InitFunc->setDSOLocal(true);
+    }
+    Builder.CreateCall(Init);
+
+    // first mask word lives in __cpu_model, the remaining three in __cpu_features2
+    auto* ModelType = llvm::StructType::get(Int32, Int32, Int32, llvm::ArrayType::get(Int32, 1));
+    auto* Features2Type = llvm::ArrayType::get(Int32, 3);
+    auto* Model = llvm::cast<llvm::GlobalValue>(Module->getOrInsertGlobal("__cpu_model", ModelType));
+    auto* Features2 = llvm::cast<llvm::GlobalValue>(Module->getOrInsertGlobal("__cpu_features2", Features2Type));
+    Model->setDSOLocal(true);
+    Features2->setDSOLocal(true);
+
+    for (const auto& [Feature, Variant] : Variants) {
+        std::array<uint32_t, 4> Mask = llvm::X86::getCpuSupportsMask({Feature});
+        llvm::Value* Supported = Builder.getTrue();
+        for (unsigned Word = 0; Word < Mask.size(); ++Word) {
+            if (!Mask[Word]) {
+                continue;
+            }
+            llvm::Value* Address = Word == 0
+                ? Builder.CreateInBoundsGEP(ModelType, Model, {Builder.getInt32(0), Builder.getInt32(3), Builder.getInt32(0)})
+                : Builder.CreateInBoundsGEP(Features2Type, Features2, {Builder.getInt32(0), Builder.getInt32(Word - 1)});
+            llvm::Value* Bits = Builder.CreateAlignedLoad(Int32, Address, llvm::Align(4));
+            llvm::Value* Masked = Builder.CreateAnd(Bits, Builder.getInt32(Mask[Word]));
+            Supported = Builder.CreateAnd(Supported, Builder.CreateICmpEQ(Masked, Builder.getInt32(Mask[Word])));
+        }
+
+        auto* Found = llvm::BasicBlock::Create(Context, Feature, Resolver);
+        auto* Next = llvm::BasicBlock::Create(Context, "next", Resolver);
+        Builder.CreateCondBr(Supported, Found, Next);
+        Builder.SetInsertPoint(Found);
+        Builder.CreateRet(Variant);
+        Builder.SetInsertPoint(Next);
+    }
+    Builder.CreateRet(Default);
+    return Resolver;
+}
+
+// where CPUID reports a feature, and the XCR0 state the OS must enable for it
+struct CpuidBit {
+    unsigned Leaf;
+    unsigned Subleaf;
+    unsigned Register; // 0 eax, 1 ebx, 2 ecx, 3 edx
+    unsigned Bit;
+    unsigned Xcr0;
+};
+
+static const unsigned Xcr0Ymm = 0x6;  // SSE + AVX state
+static const unsigned Xcr0Zmm = 0xE6; // plus opmask and upper ZMM state
+
+static const std::map<std::string, CpuidBit> CpuidFeatures = {
+    {"cmov", {1, 0, 3, 15, 0}},
+    {"mmx", {1, 0, 3, 23, 0}},
+    {"sse", {1, 0, 3, 25, 0}},
+    {"sse2", {1, 0, 3, 26, 0}},
+    {"sse3", {1, 0, 2, 0, 0}},
+    {"pclmul", {1, 0, 2, 1, 0}},
+    {"ssse3", {1, 0, 2, 9, 0}},
+    {"fma", {1, 0, 2, 12, Xcr0Ymm}},
+    {"cx16", {1, 0, 2, 13, 0}},
+    {"sse4.1", {1, 0, 2, 19, 0}},
+    {"sse4.2", {1, 0, 2, 20, 0}},
+    {"movbe", {1, 0, 2, 22, 0}},
+    {"popcnt", {1, 0, 2, 23, 0}},
+    {"aes", {1, 0, 2, 25, 0}},
+    {"avx", {1, 0, 2, 28, Xcr0Ymm}},
+    {"f16c", {1, 0, 2, 29, Xcr0Ymm}},
+    {"rdrnd", {1, 0, 2, 30, 0}},
+    {"bmi", {7, 0, 1, 3, 0}},
+    {"avx2", {7, 0, 1, 5, Xcr0Ymm}},
+    {"bmi2", {7, 0, 1, 8, 0}},
+    {"avx512f", {7, 0, 1, 16, Xcr0Zmm}},
+    {"avx512dq", {7, 0, 1, 17, Xcr0Zmm}},
+    {"rdseed", {7, 0, 1, 18, 0}},
+    {"adx", {7, 0, 1, 19, 0}},
+    {"avx512ifma", {7, 0, 1, 21, Xcr0Zmm}},
+    {"avx512cd", {7, 0, 1, 28, Xcr0Zmm}},
+    {"sha", {7, 0, 1, 29, 0}},
+    {"avx512bw", {7, 0, 1, 30, Xcr0Zmm}},
+    {"avx512vl", {7, 0, 1, 31, Xcr0Zmm}},
+    {"avx512vbmi", {7, 0, 2, 1, Xcr0Zmm}},
+    {"avx512vbmi2", {7, 0, 2, 6, Xcr0Zmm}},
+    {"gfni", {7, 0, 2, 8, 0}},
+    {"vaes", {7, 0, 2, 9, Xcr0Ymm}},
+    {"vpclmulqdq", {7, 0, 2, 10, Xcr0Ymm}},
+    {"avx512vnni", {7, 0, 2, 11, Xcr0Zmm}},
+    {"avx512bitalg", {7, 0, 2, 12, Xcr0Zmm}},
+    {"avx512vpopcntdq", {7, 0, 2, 14, Xcr0Zmm}},
+    {"avx512vp2intersect", {7, 0, 3, 8, Xcr0Zmm}},
+    {"avx512fp16", {7, 0, 3, 23, Xcr0Zmm}},
+    {"avxvnni", {7, 1, 0, 4, Xcr0Ymm}},
+    {"avx512bf16", {7, 1, 0, 5, Xcr0Zmm}},
+    {"lzcnt", {0x80000001, 0, 2, 5, 0}},
+    {"sse4a", {0x80000001, 0, 2, 6, 0}},
+    {"xop", {0x80000001, 0, 2, 11, Xcr0Ymm}},
+    {"fma4", {0x80000001, 0, 2, 16, Xcr0Ymm}},
+};
+
+// ptr @f.resolver() for runtimes without __cpu_model (MSVC): query CPUID and
+// XGETBV directly; the dispatch thunk caches the result, so this runs once
+llvm::Function* Generator::CreateCpuidResolver(llvm::Function* Default, const std::vector<std::pair<std::string, llvm::Function*>>& Variants) {
+    llvm::Module* Module = this->GetModulePtr();
+    llvm::LLVMContext& Context = Module->getContext();
+    llvm::Type* Int32 = llvm::Type::getInt32Ty(Context);
+    llvm::Type* Ptr = llvm::PointerType::getUnqual(Context);
+
+    auto* Resolver = llvm::Function::Create(llvm::FunctionType::get(Ptr, false), llvm::GlobalValue::InternalLinkage,
+                                            Default->getName().drop_back(std::strlen(".default")) + ".resolver", Module);
+    llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(Context, "entry", Resolver));
+
+    auto* CpuidType = llvm::FunctionType::get(llvm::StructType::get(Int32, Int32, Int32, Int32), {Int32, Int32}, false);
+    auto* Cpuid = llvm::InlineAsm::get(CpuidType, "cpuid", "={ax},={bx},={cx},={dx},{ax},{cx},~{dirflag},~{fpsr},~{flags}", false);
+    auto* XgetbvType = llvm::FunctionType::get(llvm::StructType::get(Int32, Int32), {Int32}, false);
+    auto* Xgetbv = llvm::InlineAsm::get(XgetbvType, "xgetbv", "={ax},={dx},{cx},~{dirflag},~{fpsr},~{flags}", false);
+
+    // leaves past the reported maximum return stale data rather than faulting, so read them and mask with the bound
+    std::map<std::pair<unsigned, unsigned>, std::array<llvm::Value*, 4>> Leaves;
+    std::map<unsigned, llvm::Value*> MaxLeaf;
+    auto Leaf = [&](unsigned Number, unsigned Subleaf) -> const std::array<llvm::Value*, 4>& {
+        auto It = Leaves.find({Number, Subleaf});
+        if (It != Leaves.end()) {
+            return It->second;
+        }
+        unsigned Base = Number & 0x80000000u;
+        if (!MaxLeaf.count(Base)) {
+            MaxLeaf[Base] = Builder.CreateExtractValue(Builder.CreateCall(Cpuid, {Builder.getInt32(Base), Builder.getInt32(0)}), 0);
+        }
+        llvm::Value* Regs = Builder.CreateCall(Cpuid, {Builder.getInt32(Number), Builder.getInt32(Subleaf)});
+        llvm::Value* Present = Builder.CreateICmpUGE(MaxLeaf[Base], Builder.getInt32(Number));
+        std::array<llvm::Value*, 4> Words;
+        for (unsigned Register = 0; Register < 4; ++Register) {
+            Words[Register] = Builder.CreateSelect(Present, Builder.CreateExtractValue(Regs, Register), Builder.getInt32(0));
+        }
+        return Leaves[{Number, Subleaf}] = Words;
+    };
+
+    // XGETBV faults unless the OS has set CR4.OSXSAVE, reported as CPUID.1:ECX bit 27
+    llvm::Value* Xcr0 = nullptr;
+    bool NeedsXcr0 = std::any_of(Variants.begin(), Variants.end(), [](const auto& Variant) { return CpuidFeatures.at(Variant.first).Xcr0 != 0; });
+    if (NeedsXcr0) {
+        llvm::Value* OsXsave = Builder.CreateAnd(Leaf(1, 0)[2], Builder.getInt32(1u << 27));
+        auto* Entry = Builder.GetInsertBlock();
+        auto* Read = llvm::BasicBlock::Create(Context, "xgetbv", Resolver);
+        auto* Probe = llvm::BasicBlock::Create(Context, "probe", Resolver);
+        Builder.CreateCondBr(Builder.CreateIsNotNull(OsXsave), Read, Probe);
+        Builder.SetInsertPoint(Read);
+        llvm::Value* State = Builder.CreateExtractValue(Builder.CreateCall(Xgetbv, {Builder.getInt32(0)}), 0);
+        Builder.CreateBr(Probe);
+        Builder.SetInsertPoint(Probe);
+        llvm::PHINode* Phi = Builder.CreatePHI(Int32, 2);
+        Phi->addIncoming(Builder.getInt32(0), Entry);
+        Phi->addIncoming(State, Read);
+        Xcr0 = Phi;
+    }
+
+    for (const auto& [Feature, Variant] : Variants) {
+        const CpuidBit& Bit = CpuidFeatures.at(Feature);
+        llvm::Value* Word = Leaf(Bit.Leaf, Bit.Subleaf)[Bit.Register];
+        llvm::Value* Supported = Builder.CreateIsNotNull(Builder.CreateAnd(Word, Builder.getInt32(1u << Bit.Bit)));
+        if (Bit.Xcr0) {
+            llvm::Value* Enabled = Builder.CreateICmpEQ(Builder.CreateAnd(Xcr0, Builder.getInt32(Bit.Xcr0)), Builder.getInt32(Bit.Xcr0));
+            Supported = Builder.CreateAnd(Supported, Enabled);
+        }
+
+        auto* Found = llvm::BasicBlock::Create(Context, Feature, Resolver);
+        auto* Next = llvm::BasicBlock::Create(Context, "next", Resolver);
+        Builder.CreateCondBr(Supported, Found, Next);
+        Builder.SetInsertPoint(Found);
+        Builder.CreateRet(Variant);
+        Builder.SetInsertPoint(Next);
+    }
+    Builder.CreateRet(Default);
+    return Resolver;
+}
+
+// @target_clones: one copy per feature set, picked at load time through an ifunc
+void Generator::CreateTargetClones(const std::vector<std::pair<llvm::Function*, const AttributeSpec*>>& Cloned) {
+    llvm::Module* Module = this->GetModulePtr();
+    const llvm::Triple& Triple = Module->getTargetTriple();
+
+    for (const auto& [Function, Attr] : Cloned) {
+        std::string Name = Function->getName().str();
+        std::string Location = " at line " + std::to_string(Attr->token.line) + ", column " + std::to_string(Attr->token.column);
+
+        if (!Triple.isX86()) {
+            Write("Code Generation", "'@target_clones' on " + Name + " ignored: CPU dispatch is only supported on x86 targets" + Location, 1, true, true, "");
+            continue;
+        }
+        // the MSVC runtime has no __cpu_model, so its resolver reads CPUID itself
+        bool UseCpuid = Triple.isWindowsMSVCEnvironment();
+
+        std::vector<std::string> Features;
+        bool Valid = true;
+        for (const auto& Feature : Attr->args) {
+            if (Feature == "default") {
+                continue;
+            }
+            if (!CloneFeatures.count(Feature)) {
+                Write("Code Generation", "Unknown feature '" + Feature + "' in '@target_clones' on " + Name + Location, 2, true, true, "");
+                Valid = false;
+            } else if (UseCpuid && !CpuidFeatures.count(Feature)) {
+                Write("Code Generation", "Feature '" + Feature + "' in '@target_clones' on " + Name +
+                      " cannot be dispatched on for " + Triple.str() + Location, 2, true, true, "");
+                Valid = false;
+            } else if (std::find(Features.begin(), Features.end(), Feature) != Features.end()) {
+                Write("Code Generation", "Duplicate feature '" + Feature + "' in '@target_clones' on " + Name + Location, 1, true, true, "");
+            } else {
+                Features.push_back(Feature);
+            }
+        }
+        if (!Valid || Features.empty()) {
+            continue;
+        }
+
+        // the resolver takes the first match, so probe the most capable feature first
+        std::stable_sort(Features.begin(), Features.end(), [](const std::string& A, const std::string& B) {
+            return CloneFeatures.at(A) > CloneFeatures.at(B);
+        });
+
+        Function->setName(Name + ".default");
+
+        std::string BaseFeatures = Function->getFnAttribute("target-features").getValueAsString().str();
+        std::vector<std::pair<std::string, llvm::Function*>> Variants;
+        for (const auto& Feature : Features) {
+            auto* Variant = llvm::Function::Create(Function->getFunctionType(), Function->getLinkage(), Name + "." + Feature, Module);
+
+            // recursion stays inside the variant instead of going back through the dispatcher
+            llvm::ValueToValueMapTy VMap;
+            VMap[Function] = Variant;
+            auto VariantArg = Variant->arg_begin();
+            for (auto& Arg : Function->args()) {
+                VariantArg->setName(Arg.getName());
+                VMap[&Arg] = &*VariantArg++;
+            }
+            llvm::SmallVector<llvm::ReturnInst*, 8> Returns;
+            llvm::CloneFunctionInto(Variant, Function, VMap, llvm::CloneFunctionChangeType::LocalChangesOnly, Returns);
+
+            Variant->addFnAttr("target-features", BaseFeatures.empty() ? "+" + Feature : BaseFeatures + ",+" + Feature);
+            Variants.push_back({Feature, Variant});
+        }
+
+        llvm::Function* Resolver = UseCpuid ? CreateCpuidResolver(Function, Variants) : CreateCloneResolver(Function, Variants);
+
+        llvm::Constant* Dispatch = nullptr;
+        if (Triple.isOSBinFormatELF()) {
+            Dispatch = llvm::GlobalIFunc::create(Function->getFunctionType(), 0, Function->getLinkage(), Name, Resolver, Module);
+        } else {
+            // no ifunc outside ELF: a thunk resolves on first call and caches the choice
+            auto* Ptr = llvm::PointerType::getUnqual(Module->getContext());
+            auto* Cache = new llvm::GlobalVariable(*Module, Ptr, false, llvm::GlobalValue::InternalLinkage,
+                                                   llvm::ConstantPointerNull::get(Ptr), Name + ".dispatch");
+            auto* Thunk = llvm::Function::Create(Function->getFunctionType(), Function->getLinkage(), Name, Module);
+            Thunk->copyAttributesFrom(Function);
+            // @pure/@const describe the body, not a thunk that writes the cache and probes the CPU
+            Thunk->removeFnAttr(llvm::Attribute::Memory);
+
+            llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(Module->getContext(), "entry", Thunk));
+            auto* Resolve = llvm::BasicBlock::Create(Module->getContext(), "resolve", Thunk);
+            auto* Call = llvm::BasicBlock::Create(Module->getContext(), "call", Thunk);
+            auto* Entry = Builder.GetInsertBlock();
+
+            // threads may race to resolve; any of them stores the same target
+            llvm::LoadInst* Cached = Builder.CreateLoad(Ptr, Cache);
+            Cached->setAtomic(llvm::AtomicOrdering::Monotonic);
+            Builder.CreateCondBr(Builder.CreateIsNull(Cached), Resolve, Call);
+
+            Builder.SetInsertPoint(Resolve);
+            llvm::Value* Resolved = Builder.CreateCall(Resolver);
+            Builder.CreateStore(Resolved, Cache)->setAtomic(llvm::AtomicOrdering::Monotonic);
+            Builder.CreateBr(Call);
+
+            Builder.SetInsertPoint(Call);
+            llvm::PHINode* Target = Builder.CreatePHI(Ptr, 2);
+            Target->addIncoming(Cached, Entry);
+            Target->addIncoming(Resolved, Resolve);
+
+            std::vector<llvm::Value*> Args;
+            for (auto& Arg : Thunk->args()) {
+                Args.push_back(&Arg);
+            }
+            llvm::CallInst* Forward = Builder.CreateCall(Function->getFunctionType(), Target, Args);
+            Forward->setTailCall();
+            if (Thunk->getReturnType()->isVoidTy()) {
+                Builder.CreateRetVoid();
+            } else {
+                Builder.CreateRet(Forward);
+            }
+            Dispatch = Thunk;
+        }
+
+        // callers go through the dispatcher; the default body keeps calling itself directly
+        Function->replaceUsesWithIf(Dispatch, [Function, Resolver](llvm::Use& U) {
+            auto* Inst = llvm::dyn_cast<llvm::Instruction>(U.getUser());
+            return !Inst || (Inst->getFunction() != Function && Inst->getFunction() != Resolver);
+        });
+
+        if (this->ASTPkg.Verbose) {
+            Write("Code Generation", "Cloned " + Name + " for " + std::to_string(Features.size()) + " target feature set(s)", 0, true, true, "");
+        }
+    }
 }
 
 void Generator::CreateEntry() {
@@ -55,20 +660,46 @@ void Generator::CreateEntry() {
 }
 
 void Generator::BuildModule() {
+    std::set<std::string> Exported;
+    std::vector<llvm::Function*> Flattened;
+    std::vector<std::pair<llvm::Function*, const AttributeSpec*>> Cloned;
     for (const auto& Statement : this->CInstance.ASTRoot->statements) {
+        FunctionNode* Func = nullptr;
         if (Statement->type == NodeType::Function) {
-            auto* Func = static_cast<FunctionNode*>(Statement.get());
-            GenerateFunction(Func, this->GetIR(), this->CInstance.FSymbolTable);
+            Func = static_cast<FunctionNode*>(Statement.get());
         }
         else if (Statement->type == NodeType::ExpressionStatement) {
             auto* Expr = static_cast<ExpressionStatementNode*>(Statement.get());
             if (Expr->expression && Expr->expression->type == NodeType::Function) {
-                auto* Func = static_cast<FunctionNode*>(Expr->expression.get());
-                GenerateFunction(Func, this->GetIR(), this->CInstance.FSymbolTable);
+                Func = static_cast<FunctionNode*>(Expr->expression.get());
+            }
+        }
+        if (Func) {
+            llvm::Function* Function = GenerateFunction(Func, this->GetIR(), this->CInstance.FSymbolTable);
+            if (Func->isExported) {
+                Exported.insert(Func->name);
+            }
+            if (Function && Func->hasAttribute("flatten")) {
+                Flattened.push_back(Function);
+            }
+            if (Function) {
+                for (const auto& Attr : Func->attributes) {
+                    if (Attr.name == "target_clones") {
+                        Cloned.push_back({Function, &Attr});
+                    }
+                }
             }
         }
     }
     CreateEntry();
+    FlattenFunctions(Flattened);
+    CreateTargetClones(Cloned);
+
+    // only main and explicit exports need to survive an executable link
+    if (ProducesExecutable()) {
+        InternalizeSymbols(Exported);
+    }
+    this->CInstance.IR->finalizeSourceLocations();
 }
 
 void Generator::PrintModule() {
@@ -84,7 +715,43 @@ void Generator::CompileTriple() {
         Target = this->ASTPkg.CompilerTarget;
     }
 
-    CreatePlatformBinary(this->TakeModule(), Target, this->ASTPkg.RunAfterCompile, this->ASTPkg.Optimisation, this->ASTPkg.OutputFile);
+    std::string LinkFlags = this->ASTPkg.ProfileGenerate ? "-fprofile-generate" : "";
+
+    std::vector<std::string> LinkInputs(InlineBitcodeFiles.begin(), InlineBitcodeFiles.end());
+    for (const auto& Input : this->ASTPkg.LinkInputs) {
+        LinkInputs.push_back(Input.string());
+    }
+
+    if (this->ASTPkg.ThinLTO) {
+        // lld performs the summary-based import and runs the backends in parallel
+        LinkFlags += (LinkFlags.empty() ? "" : " ") + std::string("-flto=thin -fuse-ld=lld");
+
+        // the post-link vectorizer runs inside lld and needs to be told about the vector library too
+        static const std::map<llvm::TargetLibraryInfoImpl::VectorLibrary, std::string> LinkerNames = {
+            {llvm::TargetLibraryInfoImpl::LIBMVEC, "LIBMVEC"}, {llvm::TargetLibraryInfoImpl::SVML, "SVML"},
+            {llvm::TargetLibraryInfoImpl::SLEEFGNUABI, "sleefgnuabi"}, {llvm::TargetLibraryInfoImpl::ArmPL, "ArmPL"},
+            {llvm::TargetLibraryInfoImpl::Accelerate, "Accelerate"}, {llvm::TargetLibraryInfoImpl::DarwinLibSystemM, "Darwin_libsystem_m"},
+            {llvm::TargetLibraryInfoImpl::AMDLIBM, "AMDLIBM"}
+        };
+        auto VecLib = LinkerNames.find(ResolveVectorLibrary());
+        if (VecLib != LinkerNames.end()) {
+            LinkFlags += " -Wl,-mllvm,-vector-library=" + VecLib->second;
+        }
+    }
+
+    // math builtins lower to libm calls (and libmvec variants, which glibc's libm pulls in);
+    // -lm has to follow the module, so it goes in with the inputs
+    const llvm::Triple& ModuleTriple = this->GetModulePtr()->getTargetTriple();
+    if (ResolveVectorLibrary() == llvm::TargetLibraryInfoImpl::SVML && ProducesExecutable()) {
+        LinkInputs.push_back(FindSvmlLibrary(ModuleTriple).string());
+    }
+    if (ModuleTriple.isOSLinux() || ModuleTriple.isOSFreeBSD() || ModuleTriple.isOSNetBSD() || ModuleTriple.isOSOpenBSD() || ModuleTriple.isOSSolaris()) {
+        LinkInputs.push_back("-lm");
+    }
+
+    CreatePlatformBinary(this->TakeModule(), Target, this->ASTPkg.RunAfterCompile, this->ASTPkg.Optimisation, this->ASTPkg.OutputFile, LinkFlags, LinkInputs, this->ASTPkg.ThinLTO, this->ASTPkg.FastCompile);
+
+    RemoveInlineBitcodeFiles();
 }
 
 bool Generator::ValidateModule() {
@@ -105,12 +772,45 @@ void Generator::OptimiseModule() {
     llvm::Module* Module = this->GetModulePtr();
     int OptLevel = this->ASTPkg.Optimisation;
     
+    llvm::TargetMachine* TM = this->CInstance.TargetMachine.get();
+    
     llvm::LoopAnalysisManager LAM;
     llvm::FunctionAnalysisManager FAM;
     llvm::CGSCCAnalysisManager CGAM;
     llvm::ModuleAnalysisManager MAM;
+
+    // clang only turns the vectorizers on from -O2 upwards, and ties interleaving to unrolling
+    llvm::PipelineTuningOptions PTO;
+    PTO.LoopVectorization = OptLevel >= 2 && this->ASTPkg.Vectorize;
+    PTO.SLPVectorization = OptLevel >= 2 && this->ASTPkg.SLPVectorize;
+    PTO.LoopUnrolling = this->ASTPkg.Unroll;
+    PTO.LoopInterleaving = this->ASTPkg.Unroll;
+    if (this->ASTPkg.InlineThreshold >= 0) {
+        PTO.InlinerThreshold = this->ASTPkg.InlineThreshold;
+    }
+
+    std::optional<llvm::PGOOptions> PGOOpt;
+    if (this->ASTPkg.ProfileGenerate) {
+        std::string RawProfile = this->ASTPkg.ProfileGenerateFile;
+        if (RawProfile.empty()) {
+            // %m lets repeated runs merge into one raw profile
+            RawProfile = (this->ASTPkg.OutputFile.parent_path() / (this->ASTPkg.OutputFile.stem().string() + "-%m.profraw")).string();
+        }
+        PGOOpt = llvm::PGOOptions(RawProfile, "", "", "", llvm::vfs::getRealFileSystem(), llvm::PGOOptions::IRInstr);
+    } else if (!this->ASTPkg.ProfileUseFile.empty()) {
+        PGOOpt = llvm::PGOOptions(this->ASTPkg.ProfileUseFile, "", "", "", llvm::vfs::getRealFileSystem(),
+                                  llvm::PGOOptions::IRUse, llvm::PGOOptions::NoCSAction, llvm::PGOOptions::ColdFuncOpt::OptSize);
+    }
     
-    llvm::PassBuilder PB;
+    llvm::PassBuilder PB(TM, PTO, PGOOpt);
+    if (TM) {
+        FAM.registerPass([TM] { return TM->getTargetIRAnalysis(); });
+    }
+
+    // registered before the defaults so the vectorizer sees the vector math library
+    llvm::TargetLibraryInfoImpl TLII(Module->getTargetTriple());
+    TLII.addVectorizableFunctionsFromVecLib(ResolveVectorLibrary(), Module->getTargetTriple());
+    FAM.registerPass([&TLII] { return llvm::TargetLibraryAnalysis(TLII); });
     PB.registerModuleAnalyses(MAM);
     PB.registerCGSCCAnalyses(CGAM);
     PB.registerFunctionAnalyses(FAM);
@@ -142,11 +842,40 @@ void Generator::OptimiseModule() {
             break;
     }
     
-    llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(LLVMOptLevel);
-    MPM.addPass(llvm::VerifierPass());
+    bool ThinLTO = this->ASTPkg.ThinLTO;
+
+    // profiles need the instrumentation and annotation stages of the full pipeline
+    bool FastPipeline = this->ASTPkg.FastCompile && !PGOOpt;
+    if (this->ASTPkg.FastCompile && PGOOpt) {
+        Write("Optimiser", "-Og uses the -O1 pipeline when generating or using a profile", 1, true, true, "");
+    }
+
+    llvm::ModulePassManager MPM;
+    if (FastPipeline) {
+        // -Og: promote allocas and clean up after them, nothing that needs loop or call graph analyses
+        MPM.addPass(llvm::AlwaysInlinerPass());
+        llvm::FunctionPassManager FPM;
+        FPM.addPass(llvm::SROAPass(llvm::SROAOptions::ModifyCFG));
+        FPM.addPass(llvm::EarlyCSEPass());
+        FPM.addPass(llvm::InstCombinePass());
+        FPM.addPass(llvm::SimplifyCFGPass());
+        MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
+    } else if (ThinLTO && OptLevel == 0) {
+        MPM = PB.buildO0DefaultPipeline(LLVMOptLevel, llvm::ThinOrFullLTOPhase::ThinLTOPreLink);
+    } else if (ThinLTO) {
+        MPM = PB.buildThinLTOPreLinkDefaultPipeline(LLVMOptLevel);
+    } else {
+        MPM = PB.buildPerModuleDefaultPipeline(LLVMOptLevel);
+    }
+    // --check is the place to pay for verification in the fast tier
+    if (!FastPipeline) {
+        MPM.addPass(llvm::VerifierPass());
+    }
 
-    if (OptLevel == 3) {
-        for (int i = 0; i < 2; ++i) {
+    // the extra rounds below belong after the link in ThinLTO mode, where the backends run them
+    if (OptLevel == 3 && !ThinLTO) {
+        int Rounds = this->ASTPkg.InlineRounds >= 0 ? this->ASTPkg.InlineRounds : 2;
+        for (int i = 0; i < Rounds; ++i) {
             llvm::CGSCCPassManager CGPM;
             CGPM.addPass(llvm::InlinerPass());
             MPM.addPass(llvm::createModuleToPostOrderCGSCCPassAdaptor(std::move(CGPM)));
@@ -159,7 +888,7 @@ void Generator::OptimiseModule() {
         }
     }
     
-    if (OptLevel >= 4) {
+    if (OptLevel >= 4 && !ThinLTO) {
         llvm::FunctionPassManager FPM;
         FPM.addPass(llvm::SCCPPass());
         MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
@@ -174,9 +903,47 @@ void Generator::OptimiseModule() {
         CGPM.addPass(llvm::InlinerPass());
         MPM.addPass(llvm::createModuleToPostOrderCGSCCPassAdaptor(std::move(CGPM)));
         
-        llvm::ModulePassManager ExtraMPM = PB.buildPerModuleDefaultPipeline(LLVMOptLevel);
-        MPM.addPass(std::move(ExtraMPM));
+        // a second default pipeline would instrument or annotate the module twice
+        if (!PGOOpt) {
+            llvm::ModulePassManager ExtraMPM = PB.buildPerModuleDefaultPipeline(LLVMOptLevel);
+            MPM.addPass(std::move(ExtraMPM));
+        }
+    }
+
+    if (PGOOpt && PGOOpt->Action == llvm::PGOOptions::IRUse && OptLevel > 0) {
+        MPM.addPass(llvm::HotColdSplittingPass());
     }
     
+    // loop attributes the optimiser could not honour arrive as failures, reported even without -Rpass
+    bool CollectRemarks = this->ASTPkg.Remarks || !this->ASTPkg.RemarksFile.empty();
+    std::string Filter;
+    if (CollectRemarks) {
+        Filter = this->ASTPkg.RemarksFilter.empty() ? "loop-vectorize|loop-unroll|inline|licm|gvn" : this->ASTPkg.RemarksFilter;
+    }
+    this->CInstance.Remarks.clear();
+    Module->getContext().setDiagnosticHandler(std::make_unique<RemarkCollector>(this->CInstance.Remarks, Filter, this->ASTPkg.InputFile));
+
     MPM.run(*Module, MAM);
+
+    Module->getContext().setDiagnosticHandler(std::make_unique<llvm::DiagnosticHandler>());
+    for (const auto& Remark : this->CInstance.Remarks) {
+        if (Remark.Kind == "Failure") {
+            std::string Where = Remark.File + (Remark.Line ? ":" + std::to_string(Remark.Line) + ":" + std::to_string(Remark.Column) : "");
+            Write("Optimiser", Where + " in " + Remark.Function + ": " + Remark.Message, 1, true, true, "");
+        }
+    }
+
+    if (CollectRemarks) {
+        RemarkAnalyzer Analyzer(this->CInstance.Remarks);
+        if (this->ASTPkg.Remarks) {
+            Analyzer.PrintRemarkReport();
+        }
+        if (!this->ASTPkg.RemarksFile.empty()) {
+            if (Analyzer.WriteRemarkFile(this->ASTPkg.RemarksFile)) {
+                Write("Optimiser", "Wrote " + std::to_string(this->CInstance.Remarks.size()) + " remarks to " + this->ASTPkg.RemarksFile, 3, true, true, "");
+            } else {
+                Write("Optimiser", "Failed to write remarks file: " + this->ASTPkg.RemarksFile, 2, true, true, "");
+            }
+        }
+    }
 }
\ No newline at end of file
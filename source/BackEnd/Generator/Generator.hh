@@ -2,6 +2,7 @@
 
 #include "AeroIR/source/AeroIR.hh"
 #include "LLVMHeader.hh"
+#include "ModuleAnalyser.hh"
 #include "Helper/Types.hh"
 
 struct GL_ASTPackage {
@@ -9,34 +10,85 @@ struct GL_ASTPackage {
     fs::path OutputFile;
 
     int Optimisation;  
+    bool FastCompile;
+    int InlineThreshold;
+    int InlineRounds;
+    bool Unroll;
+    bool Vectorize;
+    bool SLPVectorize;
     std::unique_ptr<ProgramNode> ASTRoot;
 
     bool Debug;
     bool Verbose;
     bool RunAfterCompile;
+    bool Remarks;
+    bool ProfileGenerate;
+    bool ThinLTO;
+    bool FastMath;
+    bool Wrapping;
+    bool StrictAliasing;
 
     std::string CompilerTarget;
+    std::string TargetCPU;
+    std::string TargetFeatures;
+    std::string RemarksFile;
+    std::string RemarksFilter;
+    std::string ProfileGenerateFile;
+    std::string ProfileUseFile;
+    std::string FPContract;
+    std::string VectorLibrary;
+    std::vector<fs::path> LinkInputs;
 };
 
 class Generator {
 private:
     void CreateEntry();
+    void CreateTargetMachine();
+    void InternalizeSymbols(const std::set<std::string>& Exported);
+    void FlattenFunctions(const std::vector<llvm::Function*>& Flattened);
+    void CreateTargetClones(const std::vector<std::pair<llvm::Function*, const AttributeSpec*>>& Cloned);
+    llvm::Function* CreateCloneResolver(llvm::Function* Default, const std::vector<std::pair<std::string, llvm::Function*>>& Variants);
+    llvm::Function* CreateCpuidResolver(llvm::Function* Default, const std::vector<std::pair<std::string, llvm::Function*>>& Variants);
+    bool ProducesExecutable() const;
+    llvm::TargetLibraryInfoImpl::VectorLibrary ResolveVectorLibrary() const;
 
     struct ASTPackage {
         fs::path InputFile;
         fs::path OutputFile;
 
         int Optimisation = 0;
-        bool Debug, Verbose, RunAfterCompile;
+        bool FastCompile = false;
+        int InlineThreshold = -1;
+        int InlineRounds = -1;
+        bool Unroll = true;
+        bool Vectorize = true;
+        bool SLPVectorize = true;
+        bool Debug, Verbose, RunAfterCompile, Remarks;
+        bool ProfileGenerate = false;
+        bool ThinLTO = false;
+        bool FastMath = false;
+        bool Wrapping = false;
+        bool StrictAliasing = true;
 
         std::string CompilerTarget;
+        std::string TargetCPU;
+        std::string TargetFeatures;
+        std::string RemarksFile;
+        std::string RemarksFilter;
+        std::string ProfileGenerateFile;
+        std::string ProfileUseFile;
+        std::string FPContract;
+        std::string VectorLibrary;
+        std::vector<fs::path> LinkInputs;
     };
 
     struct CompilerInstance {
         FunctionSymbols FSymbolTable;
         std::unique_ptr<AeroIR> IR;
+        std::unique_ptr<llvm::TargetMachine> TargetMachine;
         std::unique_ptr<ProgramNode> ASTRoot;
         FunctionNode MainFunc;
+        std::vector<OptimisationRemark> Remarks;
         
         CompilerInstance() {}
     };
@@ -60,6 +112,10 @@ public:
         return *this->CInstance.IR->getBuilder();
     }
 
+    llvm::TargetMachine* GetTargetMachine() {
+        return this->CInstance.TargetMachine.get();
+    }
+
     AeroIR* GetIR() {
         return this->CInstance.IR.get();
     }
@@ -73,6 +129,7 @@ public:
     }
 
     Generator(GL_ASTPackage& pkg);
+    ~Generator();
 
     void BuildModule();
     void PrintModule();
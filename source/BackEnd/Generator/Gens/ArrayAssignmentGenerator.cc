@@ -1,6 +1,45 @@
 #include "ArrayAssignmentGenerator.hh"
 #include "ExpressionGenerator.hh"
 
+// heap arrays and `T[]` parameters are stored with their declared element type;
+// like C there is no length to check them against
+static llvm::Value* StorePointerArrayElement(ArrayAssignmentNode* ArrayAssign, llvm::Value* arrayVar, llvm::Value* rvalue,
+                                             AeroIR* IR, FunctionSymbols& Methods, const std::string& StmtLocation) {
+    if (ArrayAssign->indexExpr->type == NodeType::Array) {
+        Write("Block Generator", "Pointer array " + ArrayAssign->identifier + " takes a single index" + StmtLocation, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Type* elementType = nullptr;
+    llvm::Value* basePtr = IR->pointerArrayBase(arrayVar, elementType);
+    llvm::Value* indexValue = GenerateExpression(ArrayAssign->indexExpr, IR, Methods);
+    if (!basePtr || !indexValue || !indexValue->getType()->isIntegerTy()) {
+        Write("Block Generator", "Invalid array index in array assignment" + StmtLocation, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Type* valueType = rvalue->getType();
+    if (valueType != elementType) {
+        if (valueType->isIntegerTy(1) && elementType->isIntegerTy()) {
+            rvalue = IR->getBuilder()->CreateZExt(rvalue, elementType);
+        } else if (valueType->isIntegerTy() && elementType->isIntegerTy()) {
+            rvalue = IR->intCast(rvalue, elementType);
+        } else if (valueType->isFloatingPointTy() && elementType->isFloatingPointTy()) {
+            rvalue = IR->floatCast(rvalue, elementType);
+        } else if (valueType->isIntegerTy() && elementType->isFloatingPointTy()) {
+            rvalue = IR->getBuilder()->CreateSIToFP(rvalue, elementType);
+        } else if (valueType->isFloatingPointTy() && elementType->isIntegerTy()) {
+            rvalue = IR->getBuilder()->CreateFPToSI(rvalue, elementType);
+        } else {
+            Write("Block Generator", "Type mismatch in array assignment" + StmtLocation, 2, true, true, "");
+            return nullptr;
+        }
+    }
+
+    IR->store(rvalue, IR->elementPtr(elementType, basePtr, {indexValue}));
+    return rvalue;
+}
+
 llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* IR, FunctionSymbols& Methods) {
     std::string StmtLocation = " at line " + std::to_string(ArrayAssign->token.line) + ", column " + std::to_string(ArrayAssign->token.column);
     
@@ -17,6 +56,12 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
     }
     
     llvm::AllocaInst* allocaInst = llvm::dyn_cast<llvm::AllocaInst>(arrayPtr);
+    llvm::Type* pointerElementType = IR->getArrayElementType(arrayPtr);
+    // char parameters still take the bounds-checked string path below
+    if (pointerElementType && (!allocaInst || !pointerElementType->isIntegerTy(8))) {
+        return StorePointerArrayElement(ArrayAssign, arrayPtr, rvalue, IR, Methods, StmtLocation);
+    }
+
     if (!allocaInst) {
         Write("Block Generator", "Array identifier is not an allocated variable: " + ArrayAssign->identifier + StmtLocation, 2, true, true, "");
         return nullptr;
@@ -33,23 +78,11 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
             return nullptr;
         }
         
-        llvm::Function* strlenFunc = IR->getRegisteredBuiltin("strlen");
-        if (!strlenFunc) {
-            IR->registerBuiltin("strlen", IR->i64(), {IR->i8ptr()});
-            strlenFunc = IR->getRegisteredBuiltin("strlen");
-        }
+        llvm::Function* strlenFunc = IR->runtimeFunction("strlen");
         
-        llvm::Function* exitFunc = IR->getRegisteredBuiltin("exit");
-        if (!exitFunc) {
-            IR->registerBuiltin("exit", IR->void_t(), {IR->i32()});
-            exitFunc = IR->getRegisteredBuiltin("exit");
-        }
+        llvm::Function* exitFunc = IR->runtimeFunction("exit");
         
-        llvm::Function* printfFunc = IR->getRegisteredBuiltin("printf");
-        if (!printfFunc) {
-            IR->registerBuiltin("printf", IR->i32(), {IR->i8ptr()});
-            printfFunc = IR->getRegisteredBuiltin("printf");
-        }
+        llvm::Function* printfFunc = IR->runtimeFunction("printf");
         
         llvm::Value* strLength = IR->call(strlenFunc, {loadedPtr});
         llvm::Value* strLengthTrunc = IR->intCast(strLength, IR->i32());
@@ -63,7 +96,7 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
         llvm::BasicBlock* errorBB = IR->createBlock("bounds_error");
         llvm::BasicBlock* validBB = IR->createBlock("valid_access");
         
-        IR->condBranch(isOutOfBounds, errorBB, validBB);
+        IR->condBranch(isOutOfBounds, errorBB, validBB, -1);
         
         IR->setInsertPoint(errorBB);
         llvm::Value* errorMsg = IR->constString("Segmentation fault: string index out of bounds\n");
@@ -118,17 +151,9 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
             
             uint64_t arraySize = arrayType->getNumElements();
             
-            llvm::Function* printfFunc = IR->getRegisteredBuiltin("printf");
-            if (!printfFunc) {
-                IR->registerBuiltin("printf", IR->i32(), {IR->i8ptr()});
-                printfFunc = IR->getRegisteredBuiltin("printf");
-            }
+            llvm::Function* printfFunc = IR->runtimeFunction("printf");
             
-            llvm::Function* exitFunc = IR->getRegisteredBuiltin("exit");
-            if (!exitFunc) {
-                IR->registerBuiltin("exit", IR->void_t(), {IR->i32()});
-                exitFunc = IR->getRegisteredBuiltin("exit");
-            }
+            llvm::Function* exitFunc = IR->runtimeFunction("exit");
             
             llvm::Value* arraySizeValue = IR->constI32(arraySize);
             llvm::Value* indexTrunc = indexValue;
@@ -141,7 +166,7 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
             llvm::BasicBlock* errorBB = IR->createBlock("array_bounds_error");
             llvm::BasicBlock* validBB = IR->createBlock("valid_array_access");
             
-            IR->condBranch(isOutOfBounds, errorBB, validBB);
+            IR->condBranch(isOutOfBounds, errorBB, validBB, -1);
             
             IR->setInsertPoint(errorBB);
             llvm::Value* errorMsg = IR->constString("Segmentation fault: array index out of bounds\n");
@@ -202,17 +227,9 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
         
         uint64_t arraySize = arrayType->getNumElements();
         
-        llvm::Function* printfFunc = IR->getRegisteredBuiltin("printf");
-        if (!printfFunc) {
-            IR->registerBuiltin("printf", IR->i32(), {IR->i8ptr()});
-            printfFunc = IR->getRegisteredBuiltin("printf");
-        }
+        llvm::Function* printfFunc = IR->runtimeFunction("printf");
         
-        llvm::Function* exitFunc = IR->getRegisteredBuiltin("exit");
-        if (!exitFunc) {
-            IR->registerBuiltin("exit", IR->void_t(), {IR->i32()});
-            exitFunc = IR->getRegisteredBuiltin("exit");
-        }
+        llvm::Function* exitFunc = IR->runtimeFunction("exit");
         
         llvm::Value* arraySizeValue = IR->constI32(arraySize);
         llvm::Value* indexTrunc = indexValue;
@@ -225,7 +242,7 @@ llvm::Value* GenerateArrayAssignment(ArrayAssignmentNode* ArrayAssign, AeroIR* I
         llvm::BasicBlock* errorBB = IR->createBlock("array_bounds_error2");
         llvm::BasicBlock* validBB = IR->createBlock("valid_array_access2");
         
-        IR->condBranch(isOutOfBounds, errorBB, validBB);
+        IR->condBranch(isOutOfBounds, errorBB, validBB, -1);
         
         IR->setInsertPoint(errorBB);
         llvm::Value* errorMsg = IR->constString("Segmentation fault: array index out of bounds\n");
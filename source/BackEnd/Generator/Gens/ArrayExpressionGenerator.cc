@@ -1,6 +1,19 @@
 #include "ArrayExpressionGenerator.hh"
 #include "ExpressionGenerator.hh"
 
+// heap arrays and `T[]` parameters are read with their declared element type;
+// strings and other untyped pointers keep the historical int read, untagged so
+// TBAA never separates it from the byte stores that write them
+static llvm::Value* LoadPointerArrayElement(llvm::Value* arrayVar, llvm::Value* indexValue, AeroIR* IR) {
+    llvm::Type* elementType = nullptr;
+    llvm::Value* basePtr = IR->pointerArrayBase(arrayVar, elementType);
+    if (elementType) {
+        return IR->load(IR->elementPtr(elementType, basePtr, {indexValue}), elementType);
+    }
+    llvm::Value* elementPtr = IR->elementPtr(IR->i32(), basePtr, {indexValue});
+    return IR->getBuilder()->CreateLoad(IR->i32(), elementPtr);
+}
+
 llvm::Value* GenerateArrayExpression(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, FunctionSymbols& Methods) {
     std::string Location = " at line " + std::to_string(Expr->token.line) + ", column " + std::to_string(Expr->token.column);
     
@@ -38,7 +51,7 @@ llvm::Value* GenerateArrayExpression(const std::unique_ptr<ASTNode>& Expr, AeroI
                     
                     if (i && j && i->getType()->isIntegerTy() && j->getType()->isIntegerTy()) {
                         std::vector<llvm::Value*> indices = {IR->constI32(0), i, j};
-                        llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                        llvm::Value* elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
                         
                         llvm::ArrayType* outerArrayType = llvm::dyn_cast<llvm::ArrayType>(allocatedType);
                         if (outerArrayType) {
@@ -50,25 +63,16 @@ llvm::Value* GenerateArrayExpression(const std::unique_ptr<ASTNode>& Expr, AeroI
                 }
             } else if (allocatedType->isArrayTy()) {
                 std::vector<llvm::Value*> indices = {IR->constI32(0), indexValue};
-                llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                llvm::Value* elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
                 
                 llvm::ArrayType* arrayType = llvm::dyn_cast<llvm::ArrayType>(allocatedType);
                 llvm::Type* elementType = arrayType ? arrayType->getElementType() : IR->i32();
                 return IR->load(elementPtr, elementType);
             } else if (allocatedType->isPointerTy()) {
-                llvm::Value* loadedPtr = IR->load(allocaInst);
-                llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(IR->i32(), loadedPtr, indexValue);
-                return IR->load(elementPtr, IR->i32());
+                return LoadPointerArrayElement(allocaInst, indexValue, IR);
             }
         } else if (arrayPtr->getType()->isPointerTy()) {
-            llvm::Type* pointeeType = arrayPtr->getType();
-            if (pointeeType->isIntegerTy()) {
-                llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(pointeeType, arrayPtr, indexValue);
-                return IR->load(elementPtr, pointeeType);
-            } else {
-                llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(IR->i32(), arrayPtr, indexValue);
-                return IR->load(elementPtr, IR->i32());
-            }
+            return LoadPointerArrayElement(arrayPtr, indexValue, IR);
         }
     }
     
@@ -32,7 +32,8 @@ llvm::Value* GenerateAssignment(AssignmentOpNode* Assign, AeroIR* IR, FunctionSy
         llvm::Type* allocatedType = allocaInst->getAllocatedType();
         
         if (allocatedType->isPointerTy()) {
-            llvm::Value* heapArrayPtr = IR->load(allocaInst);
+            llvm::Type* elementType = nullptr;
+            llvm::Value* heapArrayPtr = IR->pointerArrayBase(allocaInst, elementType);
             llvm::Value* indexValue = GenerateExpression(ArrayAccess->expr, IR, Methods);
             
             if (!indexValue || !indexValue->getType()->isIntegerTy()) {
@@ -40,7 +41,9 @@ llvm::Value* GenerateAssignment(AssignmentOpNode* Assign, AeroIR* IR, FunctionSy
                 return nullptr;
             }
             
-            llvm::Type* elementType = allocatedType;
+            if (!elementType) {
+                elementType = IR->i32();
+            }
             if (rvalue->getType() != elementType) {
                 if (elementType->isIntegerTy(32) && rvalue->getType()->isFloatingPointTy()) {
                     rvalue = IR->getBuilder()->CreateFPToSI(rvalue, elementType);
@@ -66,7 +69,7 @@ llvm::Value* GenerateAssignment(AssignmentOpNode* Assign, AeroIR* IR, FunctionSy
                 }
             }
             
-            llvm::Value* elementPtr = IR->arrayAccess(heapArrayPtr, indexValue);
+            llvm::Value* elementPtr = IR->elementPtr(elementType, heapArrayPtr, {indexValue});
             IR->store(rvalue, elementPtr);
             return rvalue;
         }
@@ -133,7 +136,7 @@ llvm::Value* GenerateAssignment(AssignmentOpNode* Assign, AeroIR* IR, FunctionSy
                 }
             }
             
-            llvm::Value* elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+            llvm::Value* elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
             IR->store(rvalue, elementPtr);
             return rvalue;
         } else {
@@ -1,5 +1,6 @@
 #include "BinaryOpGenerator.hh"
 #include "ExpressionGenerator.hh"
+#include "ShortCircuitGenerator.hh"
 
 llvm::Value* GenerateBinaryOp(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Expr) {
@@ -14,7 +15,11 @@ llvm::Value* GenerateBinaryOp(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR,
         Write("Binary Expression", "Failed to cast ASTNode to BinaryOpNode" + Location, 2, true, true, "");
         return nullptr;
     }
-       
+
+    if (BinOpNode->op == "&&" || BinOpNode->op == "||") {
+        return GenerateShortCircuit(BinOpNode, IR, Methods, GenerateExpression);
+    }
+
     llvm::Value* Left = GenerateExpression(BinOpNode->left, IR, Methods);
     if (!Left) {
         Write("Binary Expression", "Invalid left expression for operator " + BinOpNode->op + Location, 2, true, true, "");
@@ -260,6 +265,16 @@ llvm::Value* GenerateBinaryOp(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR,
     } else if (BinOpNode->op == "*") {
         promoteToCommonType(Left, Right);
         return IR->mul(Left, Right);
+    } else if (BinOpNode->op == "+%" || BinOpNode->op == "-%" || BinOpNode->op == "*%") {
+        // two's complement wrap-around regardless of --wrapping
+        if (!Left->getType()->isIntegerTy() || !Right->getType()->isIntegerTy()) {
+            Write("Binary Expression", "Wrapping operator '" + BinOpNode->op + "' requires integer operands" + Location, 2, true, true, "");
+            return nullptr;
+        }
+        promoteToCommonType(Left, Right);
+        if (BinOpNode->op == "+%") return IR->wrappingAdd(Left, Right);
+        if (BinOpNode->op == "-%") return IR->wrappingSub(Left, Right);
+        return IR->wrappingMul(Left, Right);
     } else if (BinOpNode->op == "/") {
         promoteToCommonType(Left, Right);
         return IR->div(Left, Right);
@@ -353,56 +368,6 @@ llvm::Value* GenerateBinaryOp(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR,
             promoteToCommonType(Left, Right);
         }
         return IR->ne(Left, Right);
-    } else if (BinOpNode->op == "&&") {
-        llvm::Value* leftBool = Left;
-        llvm::Value* rightBool = Right;
-        
-        if (!Left->getType()->isIntegerTy(1)) {
-            if (Left->getType()->isFloatingPointTy()) {
-                llvm::Value* zero = llvm::ConstantFP::get(Left->getType(), 0.0);
-                leftBool = IR->getBuilder()->CreateFCmpONE(Left, zero);
-            } else if (Left->getType()->isIntegerTy()) {
-                llvm::Value* zero = llvm::ConstantInt::get(Left->getType(), 0);
-                leftBool = IR->getBuilder()->CreateICmpNE(Left, zero);
-            }
-        }
-        
-        if (!Right->getType()->isIntegerTy(1)) {
-            if (Right->getType()->isFloatingPointTy()) {
-                llvm::Value* zero = llvm::ConstantFP::get(Right->getType(), 0.0);
-                rightBool = IR->getBuilder()->CreateFCmpONE(Right, zero);
-            } else if (Right->getType()->isIntegerTy()) {
-                llvm::Value* zero = llvm::ConstantInt::get(Right->getType(), 0);
-                rightBool = IR->getBuilder()->CreateICmpNE(Right, zero);
-            }
-        }
-        
-        return IR->and_(leftBool, rightBool);
-    } else if (BinOpNode->op == "||") {
-        llvm::Value* leftBool = Left;
-        llvm::Value* rightBool = Right;
-        
-        if (!Left->getType()->isIntegerTy(1)) {
-            if (Left->getType()->isFloatingPointTy()) {
-                llvm::Value* zero = llvm::ConstantFP::get(Left->getType(), 0.0);
-                leftBool = IR->getBuilder()->CreateFCmpONE(Left, zero);
-            } else if (Left->getType()->isIntegerTy()) {
-                llvm::Value* zero = llvm::ConstantInt::get(Left->getType(), 0);
-                leftBool = IR->getBuilder()->CreateICmpNE(Left, zero);
-            }
-        }
-        
-        if (!Right->getType()->isIntegerTy(1)) {
-            if (Right->getType()->isFloatingPointTy()) {
-                llvm::Value* zero = llvm::ConstantFP::get(Right->getType(), 0.0);
-                rightBool = IR->getBuilder()->CreateFCmpONE(Right, zero);
-            } else if (Right->getType()->isIntegerTy()) {
-                llvm::Value* zero = llvm::ConstantInt::get(Right->getType(), 0);
-                rightBool = IR->getBuilder()->CreateICmpNE(Right, zero);
-            }
-        }
-        
-        return IR->or_(leftBool, rightBool);
     } else {
         Write("Binary Expression", "Unsupported binary operator: " + BinOpNode->op + Location, 2, true, true, "");
         return nullptr;
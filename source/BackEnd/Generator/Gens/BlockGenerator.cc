@@ -12,9 +12,23 @@
 #include "BreakGenerator.hh"
 #include "ForGenerator.hh"
 #include "IfGenerator.hh"
+#include "MatchGenerator.hh"
 
 #include <iostream>
 
+llvm::FastMathFlags FastMathFromAttributes(const std::vector<AttributeSpec>& Attributes) {
+    llvm::FastMathFlags Flags;
+    for (const auto& Attr : Attributes) {
+        if (Attr.name == "fastmath") {
+            Flags.setFast();
+        } else if (Attr.name == "fp_reassoc") {
+            Flags.setAllowReassoc();
+            Flags.setAllowContract();
+        }
+    }
+    return Flags;
+}
+
 void ProcessStatement(const std::unique_ptr<ASTNode>& Statement, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Statement) {
         Write("Block Generator", "Null statement", 2, true, true, "");
@@ -27,6 +41,8 @@ void ProcessStatement(const std::unique_ptr<ASTNode>& Statement, AeroIR* IR, Fun
     if (currentBlock && currentBlock->getTerminator()) {
         return;
     }
+
+    IR->setSourceLocation(Statement->token.line, Statement->token.column);
     
     if (Statement->type == NodeType::If) {
         auto* If = static_cast<IfNode*>(Statement.get());
@@ -35,6 +51,8 @@ void ProcessStatement(const std::unique_ptr<ASTNode>& Statement, AeroIR* IR, Fun
             return;
         }
         GenerateIf(If, IR, Methods);
+    } else if (Statement->type == NodeType::Match) {
+        GenerateMatch(static_cast<MatchNode*>(Statement.get()), IR, Methods);
     } else if (Statement->type == NodeType::Variable) {
         auto* Var = static_cast<VariableNode*>(Statement.get());
         if (!Var) {
@@ -119,10 +137,23 @@ void ProcessStatement(const std::unique_ptr<ASTNode>& Statement, AeroIR* IR, Fun
             return;
         }
         
+        for (const auto& Attr : NestedBlock->attributes) {
+            if (Attr.name != "fastmath" && Attr.name != "fp_reassoc") {
+                Write("Block Generator", "Attribute '@" + Attr.name + "' cannot be applied to a block (only @fastmath and @fp_reassoc)" + StmtLocation, 2, true, true, "");
+                return;
+            }
+            if (!Attr.args.empty()) {
+                Write("Block Generator", "Attribute '@" + Attr.name + "' takes no arguments" + StmtLocation, 2, true, true, "");
+                return;
+            }
+        }
+
         auto TempBlock = std::make_unique<BlockNode>();
         TempBlock->token = NestedBlock->token;
         TempBlock->statements = std::move(const_cast<std::vector<std::unique_ptr<ASTNode>>&>(NestedBlock->statements));
+        IR->pushFastMath(FastMathFromAttributes(NestedBlock->attributes));
         GenerateBlock(TempBlock, IR, Methods);
+        IR->popFastMath();
     } else if (Statement->type == NodeType::For) {
         auto* For = static_cast<ForNode*>(Statement.get());
         if (!For) {
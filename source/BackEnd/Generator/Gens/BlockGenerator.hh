@@ -3,4 +3,7 @@
 #include "../Helper/Types.hh"
 #include "../LLVMHeader.hh"
 
+// FastMathFlags requested by @fastmath / @fp_reassoc on a function or block
+llvm::FastMathFlags FastMathFromAttributes(const std::vector<AttributeSpec>& Attributes);
+
 void GenerateBlock(const std::unique_ptr<BlockNode>& Node, AeroIR* IR, FunctionSymbols& Methods);
\ No newline at end of file
@@ -15,8 +15,9 @@ llvm::Value* GenerateCall(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, Func
         return nullptr;
     }
     
+    // user functions shadow builtins of the same name (log, round, fma, ...)
     auto BuiltinIt = BuiltIns.find(FuncCallNode->name);
-    if (BuiltinIt != BuiltIns.end()) {
+    if (BuiltinIt != BuiltIns.end() && Methods.find(FuncCallNode->name) == Methods.end()) {
         llvm::Value* Result = BuiltinIt->second(FuncCallNode->arguments, IR, Methods);
         if (!Result) {
             Write("Function Call", "Failed to execute builtin function: " + FuncCallNode->name + Location, 2, true, true, "");
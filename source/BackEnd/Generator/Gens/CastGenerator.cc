@@ -83,11 +83,7 @@ llvm::Value* GenerateCast(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, Func
             return IR->intCast(firstChar, TargetType);
         }
     } else if (SourceType->isPointerTy() && TargetType->isFloatingPointTy()) {
-        llvm::Function* strtodFunc = IR->getRegisteredBuiltin("strtod");
-        if (!strtodFunc) {
-            std::vector<llvm::Type*> strtodArgs = {IR->string_t(), IR->ptr(IR->string_t())};
-            strtodFunc = IR->createBuiltinFunction("strtod", IR->double_t(), strtodArgs);
-        }
+        llvm::Function* strtodFunc = IR->runtimeFunction("strtod");
         llvm::Value* nullPtr = llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(IR->ptr(IR->string_t())));
         llvm::Value* doubleResult = IR->call(strtodFunc, {ExprValue, nullPtr});
         
@@ -103,11 +99,7 @@ llvm::Value* GenerateCast(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, Func
             return nullptr;
         }
 
-        llvm::Function* sprintfFunc = IR->getRegisteredBuiltin("sprintf");
-        if (!sprintfFunc) {
-            std::vector<llvm::Type*> sprintfArgs = {IR->string_t(), IR->string_t()};
-            sprintfFunc = IR->createBuiltinFunction("sprintf", IR->i32(), sprintfArgs);
-        }
+        llvm::Function* sprintfFunc = IR->runtimeFunction("sprintf");
 
         llvm::Value* formatStr = IR->constString("%d");
         IR->call(sprintfFunc, {bufferPtr, formatStr, ExprValue});
@@ -119,11 +111,7 @@ llvm::Value* GenerateCast(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR, Func
             return nullptr;
         }
 
-        llvm::Function* sprintfFunc = IR->getRegisteredBuiltin("sprintf");
-        if (!sprintfFunc) {
-            std::vector<llvm::Type*> sprintfArgs = {IR->string_t(), IR->string_t()};
-            sprintfFunc = IR->createBuiltinFunction("sprintf", IR->i32(), sprintfArgs);
-        }
+        llvm::Function* sprintfFunc = IR->runtimeFunction("sprintf");
 
         llvm::Value* formatStr = IR->constString("%.6f");
         
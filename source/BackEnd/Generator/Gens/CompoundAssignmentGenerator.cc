@@ -68,18 +68,19 @@ llvm::Value* GenerateCompoundAssignment(CompoundAssignmentOpNode* CompoundAssign
             return nullptr;
         }
         
+        // heap arrays are bound to their malloc result rather than an alloca
         llvm::AllocaInst* allocaInst = llvm::dyn_cast<llvm::AllocaInst>(arrayPtr);
-        if (!allocaInst) {
+        if (!allocaInst && !IR->getArrayElementType(arrayPtr)) {
             Write("Block Generator", "Array identifier is not an allocated variable: " + ArrayAccess->identifier + StmtLocation, 2, true, true, "");
             return nullptr;
         }
         
-        llvm::Type* allocatedType = allocaInst->getAllocatedType();
+        llvm::Type* allocatedType = allocaInst ? allocaInst->getAllocatedType() : arrayPtr->getType();
         llvm::Value* elementPtr = nullptr;
         llvm::Type* elementType = nullptr;
         
         if (allocatedType->isPointerTy()) {
-            llvm::Value* heapArrayPtr = IR->load(allocaInst);
+            llvm::Value* heapArrayPtr = IR->pointerArrayBase(arrayPtr, elementType);
             llvm::Value* indexValue = GenerateExpression(ArrayAccess->expr, IR, Methods);
             
             if (!indexValue || !indexValue->getType()->isIntegerTy()) {
@@ -87,8 +88,11 @@ llvm::Value* GenerateCompoundAssignment(CompoundAssignmentOpNode* CompoundAssign
                 return nullptr;
             }
             
-            elementType = allocatedType;
-            elementPtr = IR->arrayAccess(heapArrayPtr, indexValue);
+            // untyped pointers are read as int, like arr[i] expressions
+            if (!elementType) {
+                elementType = IR->i32();
+            }
+            elementPtr = IR->elementPtr(elementType, heapArrayPtr, {indexValue});
         } else {
             if (ArrayAccess->expr->type == NodeType::Array) {
                 auto* IndexArrayPtr = static_cast<ArrayNode*>(ArrayAccess->expr.get());
@@ -128,7 +132,7 @@ llvm::Value* GenerateCompoundAssignment(CompoundAssignmentOpNode* CompoundAssign
                 }
                 
                 elementType = currentType;
-                elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
             } else {
                 llvm::Value* indexValue = GenerateExpression(ArrayAccess->expr, IR, Methods);
                 if (!indexValue || !indexValue->getType()->isIntegerTy()) {
@@ -162,7 +166,7 @@ llvm::Value* GenerateCompoundAssignment(CompoundAssignmentOpNode* CompoundAssign
                     indexValue
                 };
                 
-                elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
             }
         }
         
@@ -1,5 +1,6 @@
 #include "ConditionGenerator.hh"
 #include "ExpressionGenerator.hh"
+#include "ShortCircuitGenerator.hh"
 
 llvm::Value* ResolveIdentifier(const std::string& name, AeroIR* IR) {
     llvm::Value* varPtr = IR->getVar(name);
@@ -69,92 +70,8 @@ llvm::Value* GenerateConditionExpression(const std::unique_ptr<ASTNode>& expr, A
             return nullptr;
         }
 
-        if (binOpNode->op == "&&") {
-            if (!binOpNode->left) {
-                Write("Condition Expression", "Null left operand for &&" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            llvm::Value* left = GenerateConditionExpression(binOpNode->left, IR, Methods);
-            if (!left) {
-                Write("Condition Expression", "Invalid left operand for &&" + Location, 2, true, true, "");
-                return nullptr;
-            }
-
-            llvm::Function* currentFunc = IR->getBuilder()->GetInsertBlock()->getParent();
-            if (!currentFunc) {
-                Write("Condition Expression", "Invalid current function for &&" + Location, 2, true, true, "");
-                return nullptr;
-            }
-
-            llvm::BasicBlock* leftBB = IR->getBuilder()->GetInsertBlock();
-            llvm::BasicBlock* rhsBB = IR->createBlock("land.rhs");
-            llvm::BasicBlock* endBB = IR->createBlock("land.end");
-            
-            IR->condBranch(left, rhsBB, endBB);
-            
-            IR->setInsertPoint(rhsBB);
-            if (!binOpNode->right) {
-                Write("Condition Expression", "Null right operand for &&" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            llvm::Value* right = GenerateConditionExpression(binOpNode->right, IR, Methods);
-            if (!right) {
-                Write("Condition Expression", "Invalid right operand for &&" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            IR->branch(endBB);
-            rhsBB = IR->getBuilder()->GetInsertBlock();
-            
-            IR->setInsertPoint(endBB);
-            llvm::PHINode* phi = IR->getBuilder()->CreatePHI(IR->bool_t(), 2, "land");
-            phi->addIncoming(IR->constBool(false), leftBB);
-            phi->addIncoming(right, rhsBB);
-            
-            return phi;
-        }
-        
-        if (binOpNode->op == "||") {
-            if (!binOpNode->left) {
-                Write("Condition Expression", "Null left operand for ||" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            llvm::Value* left = GenerateConditionExpression(binOpNode->left, IR, Methods);
-            if (!left) {
-                Write("Condition Expression", "Invalid left operand for ||" + Location, 2, true, true, "");
-                return nullptr;
-            }
-
-            llvm::Function* currentFunc = IR->getBuilder()->GetInsertBlock()->getParent();
-            if (!currentFunc) {
-                Write("Condition Expression", "Invalid current function for ||" + Location, 2, true, true, "");
-                return nullptr;
-            }
-
-            llvm::BasicBlock* leftBB = IR->getBuilder()->GetInsertBlock();
-            llvm::BasicBlock* rhsBB = IR->createBlock("lor.rhs");
-            llvm::BasicBlock* endBB = IR->createBlock("lor.end");
-            
-            IR->condBranch(left, endBB, rhsBB);
-            
-            IR->setInsertPoint(rhsBB);
-            if (!binOpNode->right) {
-                Write("Condition Expression", "Null right operand for ||" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            llvm::Value* right = GenerateConditionExpression(binOpNode->right, IR, Methods);
-            if (!right) {
-                Write("Condition Expression", "Invalid right operand for ||" + Location, 2, true, true, "");
-                return nullptr;
-            }
-            IR->branch(endBB);
-            rhsBB = IR->getBuilder()->GetInsertBlock();
-            
-            IR->setInsertPoint(endBB);
-            llvm::PHINode* phi = IR->getBuilder()->CreatePHI(IR->bool_t(), 2, "lor");
-            phi->addIncoming(IR->constBool(true), leftBB);
-            phi->addIncoming(right, rhsBB);
-            
-            return phi;
+        if (binOpNode->op == "&&" || binOpNode->op == "||") {
+            return GenerateShortCircuit(binOpNode, IR, Methods, GenerateConditionExpression);
         }
 
         if (!binOpNode->left || !binOpNode->right) {
@@ -201,10 +118,7 @@ llvm::Value* GenerateConditionExpression(const std::unique_ptr<ASTNode>& expr, A
         }
 
         if (leftType->isPointerTy() && rightType->isPointerTy()) {
-            llvm::Function* strcmpFunc = IR->getModule()->getFunction("strcmp");
-            if (!strcmpFunc) {
-                strcmpFunc = IR->createBuiltinFunction("strcmp", IR->i32(), {IR->string_t(), IR->string_t()});
-            }
+            llvm::Function* strcmpFunc = IR->runtimeFunction("strcmp");
 
             llvm::Value* cmpResult = IR->call(strcmpFunc, {left, right});
             if (!cmpResult) {
@@ -1,24 +1,178 @@
 #include "ExpressionGenerator.hh"
 #include "DefaultSymbols.hh"
 
+// truth value of an int, float, pointer or bool; nullptr for anything else
+static llvm::Value* ToTruthValue(llvm::Value* Value, AeroIR* IR) {
+    llvm::Type* Type = Value->getType();
+    if (Type->isIntegerTy(1)) {
+        return Value;
+    } else if (Type->isIntegerTy()) {
+        return IR->ne(Value, llvm::ConstantInt::get(Type, 0));
+    } else if (Type->isFloatingPointTy()) {
+        return IR->getBuilder()->CreateFCmpONE(Value, llvm::ConstantFP::get(Type, 0.0));
+    } else if (Type->isPointerTy()) {
+        return IR->ne(Value, llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(Type)));
+    }
+    return nullptr;
+}
+
+// likely(x)/unlikely(x): the truth value of x, annotated with llvm.expect
+static llvm::Value* GenerateExpect(const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods, bool Expected) {
+    std::string Name = Expected ? "likely" : "unlikely";
+    if (args.size() != 1) {
+        Write("Expression Generation", Name + " expects exactly one argument", 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Value* ArgValue = GenerateExpression(args[0], IR, Methods);
+    std::string Location = " at line " + std::to_string(args[0]->token.line) + ", column " + std::to_string(args[0]->token.column);
+    if (!ArgValue) {
+        Write("Expression Generation", "Invalid argument expression for " + Name + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    ArgValue = ToTruthValue(ArgValue, IR);
+    if (!ArgValue) {
+        Write("Expression Generation", "Unsupported argument type for " + Name + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    return IR->getBuilder()->CreateIntrinsic(llvm::Intrinsic::expect, {IR->bool_t()}, {ArgValue, IR->constBool(Expected)});
+}
+
+static bool ConstantArgument(const std::unique_ptr<ASTNode>& Arg, AeroIR* IR, FunctionSymbols& Methods, const std::string& Name, int64_t& Out) {
+    llvm::Value* Value = GenerateExpression(Arg, IR, Methods);
+    auto* Constant = Value ? llvm::dyn_cast<llvm::ConstantInt>(Value) : nullptr;
+    if (!Constant) {
+        Write("Expression Generation", Name + " expects an integer constant at line " + std::to_string(Arg->token.line) +
+              ", column " + std::to_string(Arg->token.column), 2, true, true, "");
+        return false;
+    }
+    Out = Constant->getSExtValue();
+    return true;
+}
+
+// base pointer of an array argument to the memory builtins. ElementType is left
+// null when only the pointer is known (parameters, heap arrays)
+static llvm::Value* ArrayBase(const std::unique_ptr<ASTNode>& Arg, AeroIR* IR, FunctionSymbols& Methods, const std::string& Name, llvm::Type*& ElementType) {
+    ElementType = nullptr;
+    std::string Location = " at line " + std::to_string(Arg->token.line) + ", column " + std::to_string(Arg->token.column);
+
+    llvm::Value* Base = nullptr;
+    if (Arg->type == NodeType::Identifier) {
+        Base = IR->getVar(static_cast<IdentifierNode*>(Arg.get())->name);
+        auto* Alloca = Base ? llvm::dyn_cast<llvm::AllocaInst>(Base) : nullptr;
+        if (auto* ArrayType = Alloca ? llvm::dyn_cast<llvm::ArrayType>(Alloca->getAllocatedType()) : nullptr) {
+            ElementType = ArrayType->getElementType();
+        } else if (Base) {
+            Base = IR->pointerArrayBase(Base, ElementType);
+        }
+    } else {
+        Base = GenerateExpression(Arg, IR, Methods);
+    }
+
+    if (!Base || !Base->getType()->isPointerTy()) {
+        Write("Expression Generation", Name + " expects an array" + Location, 2, true, true, "");
+        return nullptr;
+    }
+    return Base;
+}
+
+// &arr[i]; arrays of unknown element type are indexed as int, like arr[i] reads
+static llvm::Value* ArrayElementAddress(llvm::Value* Base, llvm::Type* ElementType, llvm::Value* Index, AeroIR* IR) {
+    if (auto* Alloca = llvm::dyn_cast<llvm::AllocaInst>(Base); Alloca && Alloca->getAllocatedType()->isArrayTy()) {
+        return IR->elementPtr(Alloca->getAllocatedType(), Base, {IR->constI64(0), Index});
+    }
+    return IR->elementPtr(ElementType ? ElementType : IR->i32(), Base, {Index});
+}
+
+struct MathIntrinsic {
+    const char* Name;
+    llvm::Intrinsic::ID ID;
+    size_t Arity;
+};
+
+// lowered to intrinsics rather than libm calls so the vectorizer can widen them,
+// either natively or through the vector math library picked by -fveclib
+static const MathIntrinsic MathIntrinsics[] = {
+    {"sqrt", llvm::Intrinsic::sqrt, 1},
+    {"fabs", llvm::Intrinsic::fabs, 1},
+    {"floor", llvm::Intrinsic::floor, 1},
+    {"ceil", llvm::Intrinsic::ceil, 1},
+    {"round", llvm::Intrinsic::round, 1},
+    {"trunc", llvm::Intrinsic::trunc, 1},
+    {"exp", llvm::Intrinsic::exp, 1},
+    {"exp2", llvm::Intrinsic::exp2, 1},
+    {"log", llvm::Intrinsic::log, 1},
+    {"log2", llvm::Intrinsic::log2, 1},
+    {"log10", llvm::Intrinsic::log10, 1},
+    {"sin", llvm::Intrinsic::sin, 1},
+    {"cos", llvm::Intrinsic::cos, 1},
+    {"tan", llvm::Intrinsic::tan, 1},
+    {"fpow", llvm::Intrinsic::pow, 2},
+    {"fmin", llvm::Intrinsic::minnum, 2},
+    {"fmax", llvm::Intrinsic::maxnum, 2},
+    {"copysign", llvm::Intrinsic::copysign, 2},
+    {"fma", llvm::Intrinsic::fma, 3},
+};
+
+// overloaded on float/double: double if any argument is double, integers are promoted
+static llvm::Value* GenerateMathIntrinsic(const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods, const MathIntrinsic& Math) {
+    std::string Name = Math.Name;
+    if (args.size() != Math.Arity) {
+        Write("Expression Generation", Name + " expects " + std::to_string(Math.Arity) + " argument" + (Math.Arity == 1 ? "" : "s") +
+              ", got " + std::to_string(args.size()), 2, true, true, "");
+        return nullptr;
+    }
+
+    std::vector<llvm::Value*> Values;
+    llvm::Type* OperandType = IR->f32();
+    for (const auto& Arg : args) {
+        llvm::Value* ArgValue = GenerateExpression(Arg, IR, Methods);
+        std::string Location = " at line " + std::to_string(Arg->token.line) + ", column " + std::to_string(Arg->token.column);
+        if (!ArgValue) {
+            Write("Expression Generation", "Invalid argument expression for " + Name + Location, 2, true, true, "");
+            return nullptr;
+        }
+
+        llvm::Type* ArgType = ArgValue->getType();
+        if (ArgType->isIntegerTy(1) || (!ArgType->isIntegerTy() && !ArgType->isFloatTy() && !ArgType->isDoubleTy())) {
+            Write("Expression Generation", Name + " expects numeric arguments" + Location, 2, true, true, "");
+            return nullptr;
+        }
+        if (ArgType->isDoubleTy()) {
+            OperandType = IR->f64();
+        }
+        Values.push_back(ArgValue);
+    }
+
+    for (auto& Value : Values) {
+        if (Value->getType()->isIntegerTy()) {
+            Value = IR->getBuilder()->CreateSIToFP(Value, OperandType);
+        } else if (Value->getType() != OperandType) {
+            Value = IR->floatCast(Value, OperandType);
+        }
+    }
+
+    return IR->getBuilder()->CreateIntrinsic(Math.ID, {OperandType}, Values);
+}
+
 void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
     if (!Builtins.empty()) return;
 
+    for (const auto& Math : MathIntrinsics) {
+        Builtins[Math.Name] = [&Math](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+            return GenerateMathIntrinsic(args, IR, Methods, Math);
+        };
+    }
+
     Builtins["print"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
         if (args.empty()) {
             Write("Expression Generation", "Empty arguments for print function", 2, true, true, "");
             return nullptr;
         }
         
-        llvm::Function* printfFunc = IR->getModule()->getFunction("printf");
-        if (!printfFunc) {
-            llvm::FunctionType* printfType = llvm::FunctionType::get(
-                IR->i32(),
-                {IR->ptr(IR->i8())},
-                true
-            );
-            printfFunc = llvm::Function::Create(printfType, llvm::Function::ExternalLinkage, "printf", IR->getModule());
-        }
+        llvm::Function* printfFunc = IR->runtimeFunction("printf");
         
         std::vector<llvm::Value*> printfArgs;
         llvm::Value* ArgValue = GenerateExpression(args[0], IR, Methods);
@@ -75,15 +229,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
             return nullptr;
         }
         
-        llvm::Function* printfFunc = IR->getModule()->getFunction("printf");
-        if (!printfFunc) {
-            llvm::FunctionType* printfType = llvm::FunctionType::get(
-                IR->i32(),
-                {IR->ptr(IR->i8())},
-                true
-            );
-            printfFunc = llvm::Function::Create(printfType, llvm::Function::ExternalLinkage, "printf", IR->getModule());
-        }
+        llvm::Function* printfFunc = IR->runtimeFunction("printf");
         
         std::vector<llvm::Value*> printfArgs;
         llvm::Value* ArgValue = GenerateExpression(args[0], IR, Methods);
@@ -135,35 +281,11 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
     };
 
     Builtins["readLine"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
-        llvm::Function* fgetsFunc = IR->getModule()->getFunction("fgets");
-        if (!fgetsFunc) {
-            llvm::FunctionType* fgetsType = llvm::FunctionType::get(
-                IR->ptr(IR->i8()),
-                {IR->ptr(IR->i8()), IR->i32(), IR->ptr(IR->i8())},
-                false
-            );
-            fgetsFunc = llvm::Function::Create(fgetsType, llvm::Function::ExternalLinkage, "fgets", IR->getModule());
-        }
-        
-        llvm::Function* stdinFunc = IR->getModule()->getFunction("__acrt_iob_func");
-        if (!stdinFunc) {
-            llvm::FunctionType* stdinType = llvm::FunctionType::get(
-                IR->ptr(IR->i8()),
-                {IR->i32()},
-                false
-            );
-            stdinFunc = llvm::Function::Create(stdinType, llvm::Function::ExternalLinkage, "__acrt_iob_func", IR->getModule());
-        }
-        
-        llvm::Function* strchrFunc = IR->getModule()->getFunction("strchr");
-        if (!strchrFunc) {
-            llvm::FunctionType* strchrType = llvm::FunctionType::get(
-                IR->ptr(IR->i8()),
-                {IR->ptr(IR->i8()), IR->i32()},
-                false
-            );
-            strchrFunc = llvm::Function::Create(strchrType, llvm::Function::ExternalLinkage, "strchr", IR->getModule());
-        }
+        llvm::Function* fgetsFunc = IR->runtimeFunction("fgets");
+        
+        llvm::Function* stdinFunc = IR->runtimeFunction("__acrt_iob_func");
+        
+        llvm::Function* strchrFunc = IR->runtimeFunction("strchr");
         
         llvm::Value* bufferPtr = IR->malloc(IR->i8(), IR->constI64(256));
         llvm::Value* stdin_ptr = IR->call(stdinFunc, {IR->constI32(0)});
@@ -238,15 +360,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
         
         llvm::Type* ArgType = ArgValue->getType();
 
-        llvm::Function* sprintfFunc = IR->getModule()->getFunction("sprintf");
-        if (!sprintfFunc) {
-            llvm::FunctionType* sprintfType = llvm::FunctionType::get(
-                IR->i32(),
-                {IR->ptr(IR->i8()), IR->ptr(IR->i8())},
-                true
-            );
-            sprintfFunc = llvm::Function::Create(sprintfType, llvm::Function::ExternalLinkage, "sprintf", IR->getModule());
-        }
+        llvm::Function* sprintfFunc = IR->runtimeFunction("sprintf");
         
         llvm::Value* bufferPtr = IR->malloc(IR->i8(), IR->constI64(32));
         if (!bufferPtr) {
@@ -307,15 +421,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
         } else if (ArgType->isIntegerTy(1)) {
             return IR->intCast(ArgValue, IR->i32());
         } else if (ArgType->isPointerTy()) {
-            llvm::Function* atoiFunc = IR->getModule()->getFunction("atoi");
-            if (!atoiFunc) {
-                llvm::FunctionType* atoiType = llvm::FunctionType::get(
-                    IR->i32(),
-                    {IR->ptr(IR->i8())},
-                    false
-                );
-                atoiFunc = llvm::Function::Create(atoiType, llvm::Function::ExternalLinkage, "atoi", IR->getModule());
-            }
+            llvm::Function* atoiFunc = IR->runtimeFunction("atoi");
             return IR->call(atoiFunc, {ArgValue});
         } else {
             Write("Expression Generation", "Unsupported argument type for int function" + Location, 2, true, true, "");
@@ -346,15 +452,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
         } else if (ArgType->isIntegerTy()) {
             return IR->getBuilder()->CreateSIToFP(ArgValue, IR->f32());
         } else if (ArgType->isPointerTy()) {
-            llvm::Function* atofFunc = IR->getModule()->getFunction("atof");
-            if (!atofFunc) {
-                llvm::FunctionType* atofType = llvm::FunctionType::get(
-                    IR->f64(),
-                    {IR->ptr(IR->i8())},
-                    false
-                );
-                atofFunc = llvm::Function::Create(atofType, llvm::Function::ExternalLinkage, "atof", IR->getModule());
-            }
+            llvm::Function* atofFunc = IR->runtimeFunction("atof");
             llvm::Value* doubleResult = IR->call(atofFunc, {ArgValue});
             return IR->floatCast(doubleResult, IR->f32());
         } else {
@@ -408,15 +506,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
                 llvm::Value* loadedPtr = IR->load(allocaInst);
                 
                 if (loadedPtr->getType() == IR->ptr(IR->i8())) {
-                    llvm::Function* strlenFunc = IR->getModule()->getFunction("strlen");
-                    if (!strlenFunc) {
-                        llvm::FunctionType* strlenType = llvm::FunctionType::get(
-                            IR->i64(),
-                            {IR->ptr(IR->i8())},
-                            false
-                        );
-                        strlenFunc = llvm::Function::Create(strlenType, llvm::Function::ExternalLinkage, "strlen", IR->getModule());
-                    }
+                    llvm::Function* strlenFunc = IR->runtimeFunction("strlen");
                     
                     llvm::Value* length = IR->call(strlenFunc, {loadedPtr});
                     return IR->intCast(length, IR->i32());
@@ -480,15 +570,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
         }
         
         if (ArgValue->getType()->isPointerTy()) {
-            llvm::Function* strlenFunc = IR->getModule()->getFunction("strlen");
-            if (!strlenFunc) {
-                llvm::FunctionType* strlenType = llvm::FunctionType::get(
-                    IR->i64(),
-                    {IR->ptr(IR->i8())},
-                    false
-                );
-                strlenFunc = llvm::Function::Create(strlenType, llvm::Function::ExternalLinkage, "strlen", IR->getModule());
-            }
+            llvm::Function* strlenFunc = IR->runtimeFunction("strlen");
             llvm::Value* length = IR->call(strlenFunc, {ArgValue});
             return IR->intCast(length, IR->i32());
         } else {
@@ -524,15 +606,7 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
     };
 
     Builtins["exit"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
-        llvm::Function* exitFunc = IR->getModule()->getFunction("exit");
-        if (!exitFunc) {
-            llvm::FunctionType* exitType = llvm::FunctionType::get(
-                IR->void_t(),
-                {IR->i32()},
-                false
-            );
-            exitFunc = llvm::Function::Create(exitType, llvm::Function::ExternalLinkage, "exit", IR->getModule());
-        }
+        llvm::Function* exitFunc = IR->runtimeFunction("exit");
         
         llvm::Value* exitCode = IR->constI32(0);
         if (!args.empty()) {
@@ -546,6 +620,120 @@ void InitializeBuiltinSymbols(BuiltinSymbols& Builtins) {
         return IR->constI32(0);
     };
 
+    Builtins["assume"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        if (args.size() != 1) {
+            Write("Expression Generation", "assume expects exactly one argument", 2, true, true, "");
+            return nullptr;
+        }
+        llvm::Value* Condition = GenerateExpression(args[0], IR, Methods);
+        Condition = Condition ? ToTruthValue(Condition, IR) : nullptr;
+        if (!Condition) {
+            Write("Expression Generation", "Invalid condition for assume at line " + std::to_string(args[0]->token.line) +
+                  ", column " + std::to_string(args[0]->token.column), 2, true, true, "");
+            return nullptr;
+        }
+        IR->getBuilder()->CreateAssumption(Condition);
+        return IR->constI32(0);
+    };
+
+    Builtins["assume_aligned"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        if (args.size() != 2) {
+            Write("Expression Generation", "assume_aligned expects an array and an alignment", 2, true, true, "");
+            return nullptr;
+        }
+        llvm::Type* ElementType = nullptr;
+        llvm::Value* Base = ArrayBase(args[0], IR, Methods, "assume_aligned", ElementType);
+        int64_t Alignment = 0;
+        if (!Base || !ConstantArgument(args[1], IR, Methods, "assume_aligned", Alignment)) {
+            return nullptr;
+        }
+        if (Alignment <= 0 || (Alignment & (Alignment - 1)) != 0) {
+            Write("Expression Generation", "assume_aligned needs a power-of-two alignment, got " + std::to_string(Alignment), 2, true, true, "");
+            return nullptr;
+        }
+        IR->getBuilder()->CreateAlignmentAssumption(IR->getModule()->getDataLayout(), Base, Alignment);
+        return Base;
+    };
+
+    // prefetch(arr, i[, rw[, locality]]): rw 0 = read, 1 = write; locality 0 (streaming) to 3 (keep in all caches)
+    Builtins["prefetch"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        if (args.size() < 2 || args.size() > 4) {
+            Write("Expression Generation", "prefetch expects (array, index[, rw[, locality]])", 2, true, true, "");
+            return nullptr;
+        }
+        llvm::Type* ElementType = nullptr;
+        llvm::Value* Base = ArrayBase(args[0], IR, Methods, "prefetch", ElementType);
+        llvm::Value* Index = Base ? GenerateExpression(args[1], IR, Methods) : nullptr;
+        if (!Index || !Index->getType()->isIntegerTy()) {
+            if (Base) Write("Expression Generation", "Invalid index for prefetch", 2, true, true, "");
+            return nullptr;
+        }
+
+        int64_t ReadWrite = 0, Locality = 3;
+        if (args.size() > 2 && !ConstantArgument(args[2], IR, Methods, "prefetch", ReadWrite)) return nullptr;
+        if (args.size() > 3 && !ConstantArgument(args[3], IR, Methods, "prefetch", Locality)) return nullptr;
+        if (ReadWrite < 0 || ReadWrite > 1 || Locality < 0 || Locality > 3) {
+            Write("Expression Generation", "prefetch rw must be 0 or 1 and locality 0 to 3", 2, true, true, "");
+            return nullptr;
+        }
+
+        llvm::Value* Address = ArrayElementAddress(Base, ElementType, Index, IR);
+        IR->getBuilder()->CreateIntrinsic(llvm::Intrinsic::prefetch, {Address->getType()},
+                                          {Address, IR->constI32(ReadWrite), IR->constI32(Locality), IR->constI32(1)});
+        return IR->constI32(0);
+    };
+
+    // nt_store(arr, i, v): streaming store that bypasses the cache
+    Builtins["nt_store"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        if (args.size() != 3) {
+            Write("Expression Generation", "nt_store expects (array, index, value)", 2, true, true, "");
+            return nullptr;
+        }
+        llvm::Type* ElementType = nullptr;
+        llvm::Value* Base = ArrayBase(args[0], IR, Methods, "nt_store", ElementType);
+        llvm::Value* Index = Base ? GenerateExpression(args[1], IR, Methods) : nullptr;
+        llvm::Value* Value = Index ? GenerateExpression(args[2], IR, Methods) : nullptr;
+        if (!Index || !Index->getType()->isIntegerTy() || !Value) {
+            if (Base) Write("Expression Generation", "Invalid index or value for nt_store", 2, true, true, "");
+            return nullptr;
+        }
+
+        // untyped pointers are indexed as int, like arr[i] reads; the value converts to match
+        if (!ElementType) {
+            ElementType = IR->i32();
+        }
+        if (Value->getType() != ElementType) {
+            llvm::Type* From = Value->getType();
+            if (From->isIntegerTy() && ElementType->isIntegerTy()) {
+                Value = IR->intCast(Value, ElementType);
+            } else if (From->isFloatingPointTy() && ElementType->isFloatingPointTy()) {
+                Value = IR->floatCast(Value, ElementType);
+            } else if (From->isIntegerTy() && ElementType->isFloatingPointTy()) {
+                Value = IR->getBuilder()->CreateSIToFP(Value, ElementType);
+            } else if (From->isFloatingPointTy() && ElementType->isIntegerTy()) {
+                Value = IR->getBuilder()->CreateFPToSI(Value, ElementType);
+            } else {
+                Write("Expression Generation", "Type mismatch in nt_store", 2, true, true, "");
+                return nullptr;
+            }
+        }
+
+        llvm::Value* Address = ArrayElementAddress(Base, ElementType, Index, IR);
+        llvm::StoreInst* Store = IR->store(Value, Address);
+        llvm::LLVMContext& Context = *IR->getContext();
+        Store->setMetadata(llvm::LLVMContext::MD_nontemporal,
+                           llvm::MDNode::get(Context, llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(llvm::Type::getInt32Ty(Context), 1))));
+        return IR->constI32(0);
+    };
+
+    Builtins["likely"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        return GenerateExpect(args, IR, Methods, true);
+    };
+
+    Builtins["unlikely"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
+        return GenerateExpect(args, IR, Methods, false);
+    };
+
     Builtins["bool"] = [](const std::vector<std::unique_ptr<ASTNode>>& args, AeroIR* IR, FunctionSymbols& Methods) -> llvm::Value* {
         if (args.empty()) {
             Write("Expression Generation", "Empty arguments for bool function", 2, true, true, "");
@@ -8,6 +8,7 @@
 #include "CompoundAssignmentGenerator.hh"
 #include "ArrayExpressionGenerator.hh"
 #include "InlineLanguageGenerator.hh"
+#include "TernaryGenerator.hh"
 #include <cmath>
 #include <functional>
 #include <unordered_map>
@@ -120,6 +121,13 @@ llvm::Value* GenerateExpression(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR
             return nullptr;
         }
         return Result;
+    } else if (Expr->type == NodeType::Ternary) {
+        llvm::Value* Result = GenerateTernary(static_cast<TernaryNode*>(Expr.get()), IR, Methods);
+        if (!Result) {
+            Write("Expression Generation", "Invalid conditional expression" + Location, 2, true, true, "");
+            return nullptr;
+        }
+        return Result;
     } else if (Expr->type == NodeType::Boolean) {
         auto* BoolNode = static_cast<BooleanNode*>(Expr.get());
         if (!BoolNode) {
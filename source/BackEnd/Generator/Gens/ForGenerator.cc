@@ -4,6 +4,7 @@
 #include "BreakGenerator.hh"
 #include "ExpressionGenerator.hh"
 #include "VariableGenerator.hh"
+#include "LoopHintGenerator.hh"
 
 llvm::Value* GenerateFor(ForNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Node) {
@@ -19,6 +20,11 @@ llvm::Value* GenerateFor(ForNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
         return nullptr;
     }
 
+    llvm::MDNode* Hints = LoopHintsFromAttributes(Node->attributes, IR);
+    if (!Node->attributes.empty() && !Hints) {
+        return nullptr;
+    }
+
     IR->pushScope();
 
     llvm::BasicBlock* ForHeader = IR->createBlock("for.header");
@@ -45,7 +51,7 @@ llvm::Value* GenerateFor(ForNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
             IR->popScope();
             return nullptr;
         }
-        IR->condBranch(Condition, ForBody, ForExit);
+        IR->condBranch(Condition, ForBody, ForExit, Node->condition->likelihood);
     } else {
         IR->branch(ForBody);
     }
@@ -55,6 +61,7 @@ llvm::Value* GenerateFor(ForNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     GenerateBlock(Node->body, IR, Methods);
     LoopExitStack.pop();
 
+    IR->setSourceLocation(Node->token.line, Node->token.column);
     if (!IR->getBuilder()->GetInsertBlock()->getTerminator()) {
         IR->branch(ForIncrement);
     }
@@ -63,7 +70,8 @@ llvm::Value* GenerateFor(ForNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     if (Node->increment) {
         GenerateExpression(Node->increment, IR, Methods);
     }
-    IR->branch(ForHeader);
+    llvm::Value* Latch = IR->branch(ForHeader);
+    AttachLoopHints(Hints, ForIncrement->hasNPredecessorsOrMore(1) ? Latch : nullptr, Node->token);
 
     IR->setInsertPoint(ForExit);
     IR->popScope();
@@ -1,7 +1,90 @@
 #include "FunctionGenerator.hh"
 #include "BlockGenerator.hh"
+#include "ReturnGenerator.hh"
 #include "../Helper/Types.hh"
 
+static const std::set<std::string> FunctionAttributeNames = {
+    "pure", "const", "hot", "cold", "flatten", "noinline", "minsize", "optnone", "fastmath", "fp_reassoc", "target_clones"
+};
+
+static bool ValidateFunctionAttributes(FunctionNode* Node) {
+    std::set<std::string> Seen;
+    for (const auto& Attr : Node->attributes) {
+        std::string Location = " at line " + std::to_string(Attr.token.line) + ", column " + std::to_string(Attr.token.column);
+        if (!FunctionAttributeNames.count(Attr.name)) {
+            Write("Function Generation", "Unknown attribute '@" + Attr.name + "' on function " + Node->name + Location, 2, true, true, "");
+            return false;
+        }
+        if (Attr.name == "target_clones") {
+            // the feature list itself is checked against the target when the clones are built
+            if (std::find(Attr.args.begin(), Attr.args.end(), "default") == Attr.args.end()) {
+                Write("Function Generation", "'@target_clones' on function " + Node->name + " needs a \"default\" variant" + Location, 2, true, true, "");
+                return false;
+            }
+            if (Node->name == "main" || Node->alwaysInline) {
+                Write("Function Generation", "'@target_clones' cannot be used on " +
+                      std::string(Node->name == "main" ? "main" : "always_inline function " + Node->name) + Location, 2, true, true, "");
+                return false;
+            }
+        } else if (!Attr.args.empty()) {
+            Write("Function Generation", "Attribute '@" + Attr.name + "' takes no arguments" + Location, 2, true, true, "");
+            return false;
+        }
+        if (!Seen.insert(Attr.name).second) {
+            Write("Function Generation", "Duplicate attribute '@" + Attr.name + "' on function " + Node->name + Location, 1, true, true, "");
+        }
+    }
+
+    auto Conflict = [&](const std::string& A, const std::string& B) {
+        if (Seen.count(A) && Seen.count(B)) {
+            Write("Function Generation", "Attributes '@" + A + "' and '@" + B + "' cannot be combined on function " + Node->name, 2, true, true, "");
+            return true;
+        }
+        return false;
+    };
+
+    if (Conflict("hot", "cold") || Conflict("optnone", "minsize") || Conflict("optnone", "flatten") || Conflict("optnone", "hot")) {
+        return false;
+    }
+    if ((Seen.count("noinline") || Seen.count("optnone")) && (Node->isInlined || Node->alwaysInline)) {
+        Write("Function Generation", "Function " + Node->name + " is declared inline but marked '@" +
+              (Seen.count("noinline") ? "noinline" : "optnone") + "'", 2, true, true, "");
+        return false;
+    }
+    if (Seen.count("fastmath") && Seen.count("fp_reassoc")) {
+        Write("Function Generation", "'@fastmath' implies '@fp_reassoc' on function " + Node->name, 1, true, true, "");
+    }
+    if (Seen.count("pure") && Seen.count("const")) {
+        Write("Function Generation", "'@const' implies '@pure' on function " + Node->name, 1, true, true, "");
+    }
+    return true;
+}
+
+static void ApplyFunctionAttributes(FunctionNode* Node, llvm::Function* Function) {
+    if (Node->hasAttribute("const")) {
+        Function->setDoesNotAccessMemory();
+    } else if (Node->hasAttribute("pure")) {
+        Function->setOnlyReadsMemory();
+    }
+    // no willreturn: a pure function may still loop forever, and claiming otherwise lets LLVM delete the loop
+    if (Node->hasAttribute("const") || Node->hasAttribute("pure")) {
+        Function->setDoesNotThrow();
+    }
+
+    if (Node->hasAttribute("hot")) Function->addFnAttr(llvm::Attribute::Hot);
+    if (Node->hasAttribute("cold")) Function->addFnAttr(llvm::Attribute::Cold);
+    if (Node->hasAttribute("noinline")) Function->addFnAttr(llvm::Attribute::NoInline);
+
+    if (Node->hasAttribute("minsize")) {
+        Function->addFnAttr(llvm::Attribute::MinSize);
+        Function->addFnAttr(llvm::Attribute::OptimizeForSize);
+    }
+    if (Node->hasAttribute("optnone")) {
+        Function->addFnAttr(llvm::Attribute::OptimizeNone);
+        Function->addFnAttr(llvm::Attribute::NoInline);
+    }
+}
+
 llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Node) {
         Write("Function Generation", "Null FunctionNode provided", 2, true, true, "");
@@ -12,6 +95,10 @@ llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols
     std::string ReturnTypeStr = Node->returnType;
     std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
 
+    if (!ValidateFunctionAttributes(Node)) {
+        return nullptr;
+    }
+
     llvm::Type* ReturnType = nullptr;
     if (ReturnTypeStr.find("[]") != std::string::npos) {
         std::string baseType = ReturnTypeStr.substr(0, ReturnTypeStr.find("[]"));
@@ -54,7 +141,7 @@ llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols
         ArgTypes.push_back(ArgType);
     }
 
-    llvm::Function* Function = IR->createFunction(Name, ReturnType, ArgTypes);
+    llvm::Function* Function = IR->createFunction(Name, ReturnType, ArgTypes, Node->token.line);
     if (!Function) {
         Write("Function Generation", "Failed to create function: " + Name + Location, 2, true, true, "");
         return nullptr;
@@ -72,6 +159,18 @@ llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols
         Function->addFnAttr(llvm::Attribute::InlineHint);
     }
 
+    ApplyFunctionAttributes(Node, Function);
+
+    for (size_t i = 0; i < Node->restrictParams.size(); ++i) {
+        if (!Node->restrictParams[i]) continue;
+        if (!ArgTypes[i]->isPointerTy()) {
+            Write("Function Generation", "'restrict' requires an array or pointer parameter, but '" + std::get<0>(Node->params[i]) +
+                  "' of function " + Name + " is " + std::get<1>(Node->params[i]) + Location, 2, true, true, "");
+            return nullptr;
+        }
+        Function->addParamAttr(i, llvm::Attribute::NoAlias);
+    }
+
     int paramIndex = 0;
     for (const auto& Arg : Node->params) {
         std::string paramName = std::get<0>(Arg);
@@ -79,10 +178,15 @@ llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols
         
         llvm::Value* param = IR->param(paramIndex);
         llvm::Value* alloca = IR->var(paramName, param->getType(), param);
+        if (paramType.find("[]") != std::string::npos) {
+            IR->setArrayElementType(alloca, GetAeroTypeFromString(paramType.substr(0, paramType.find("[]")), IR));
+        }
         paramIndex++;
     }
 
+    IR->pushFastMath(FastMathFromAttributes(Node->attributes));
     GenerateBlock(Node->body, IR, Methods);
+    IR->popFastMath();
 
     llvm::BasicBlock* currentBlock = IR->getBuilder()->GetInsertBlock();
     if (!currentBlock->getTerminator()) {
@@ -115,6 +219,10 @@ llvm::Function* GenerateFunction(FunctionNode* Node, AeroIR* IR, FunctionSymbols
         }
     }
 
+    if (!FinalizeTailCalls(Function)) {
+        return nullptr;
+    }
+
     IR->endFunction();
 
     return Function;
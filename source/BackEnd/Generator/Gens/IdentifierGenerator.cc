@@ -16,6 +16,11 @@ llvm::Value* GenerateIdentifier(const std::unique_ptr<ASTNode>& Expr, AeroIR* IR
     
     llvm::Value* varPtr = IR->getVar(Identifier->name);
     
+    // a heap array is bound to its malloc result and is passed on as that pointer
+    if (varPtr && !llvm::isa<llvm::AllocaInst>(varPtr) && IR->getArrayElementType(varPtr)) {
+        return varPtr;
+    }
+
     if (varPtr) {
         return IR->load(varPtr);
     } else {
@@ -53,7 +53,7 @@ llvm::Value* GenerateIf(IfNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
         llvm::BasicBlock* nextCondition = (i + 1 < Node->branches.size()) ? conditionBBs[i + 1] : 
                                          (elseBB ? elseBB : mergeBB);
 
-        IR->condBranch(condValue, bodyBBs[i], nextCondition);
+        IR->condBranch(condValue, bodyBBs[i], nextCondition, branch.condition->likelihood);
 
         IR->setInsertPoint(bodyBBs[i]);
         IR->pushScope();
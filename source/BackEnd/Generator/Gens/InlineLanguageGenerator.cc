@@ -4,6 +4,16 @@
 #include <cstdlib>
 #include <random>
 
+bool InlineThinLTO = false;
+std::vector<std::string> InlineBitcodeFiles;
+
+void RemoveInlineBitcodeFiles() {
+    for (const auto& BitcodeFile : InlineBitcodeFiles) {
+        std::remove(BitcodeFile.c_str());
+    }
+    InlineBitcodeFiles.clear();
+}
+
 std::vector<llvm::Value*> ExtractVariableReferences(const std::string& code, AeroIR* IR) {
     std::vector<llvm::Value*> inputs;
     std::regex varPattern(R"(\$([a-zA-Z_][a-zA-Z0-9_]*)\b)");
@@ -155,7 +165,8 @@ llvm::Value* CompileWithClang(const std::string& code, const std::string& lang,
     file.close();
     
     std::string compiler = (lang == "c") ? "clang" : "clang++";
-    std::string cmd = compiler + " -emit-llvm -c -O2 \"" + tempFile + "\" -o \"" + bcFile + "\"";
+    std::string ltoFlag = InlineThinLTO ? " -flto=thin" : "";
+    std::string cmd = compiler + " -emit-llvm -c -O2" + ltoFlag + " \"" + tempFile + "\" -o \"" + bcFile + "\"";
     
     if (system(cmd.c_str()) != 0) {
         std::remove(tempFile.c_str());
@@ -180,16 +191,31 @@ llvm::Value* CompileWithClang(const std::string& code, const std::string& lang,
         }
     }
     
-    llvm::Linker linker(*IR->getModule());
-    if (linker.linkInModule(std::move(inlineModule))) {
+    if (InlineThinLTO) {
+        // only the declaration goes into the module; the body is imported at link time
+        llvm::Function* inlineDef = inlineModule->getFunction(actualFuncName);
+        if (!inlineDef) {
+            std::remove(tempFile.c_str());
+            std::remove(bcFile.c_str());
+            return nullptr;
+        }
+        IR->getModule()->getOrInsertFunction(actualFuncName, inlineDef->getFunctionType());
+        static bool CleanupRegistered = (std::atexit(RemoveInlineBitcodeFiles), true);
+        (void)CleanupRegistered;
+        InlineBitcodeFiles.push_back(bcFile);
+        std::remove(tempFile.c_str());
+    } else {
+        llvm::Linker linker(*IR->getModule());
+        if (linker.linkInModule(std::move(inlineModule))) {
+            std::remove(tempFile.c_str());
+            std::remove(bcFile.c_str());
+            return nullptr;
+        }
+        
         std::remove(tempFile.c_str());
         std::remove(bcFile.c_str());
-        return nullptr;
     }
     
-    std::remove(tempFile.c_str());
-    std::remove(bcFile.c_str());
-    
     llvm::Function* inlineFunc = IR->getModule()->getFunction(actualFuncName);
     if (inlineFunc) {
         llvm::Value* result = IR->call(inlineFunc, inputs);
@@ -3,4 +3,11 @@
 #include "../Helper/Types.hh"
 #include "../LLVMHeader.hh"
 
+// when set, inline C/C++ is kept as separate ThinLTO bitcode instead of being linked into the module
+extern bool InlineThinLTO;
+extern std::vector<std::string> InlineBitcodeFiles;
+
+// deletes the ThinLTO bitcode above; also runs at exit so error paths do not leave it behind
+void RemoveInlineBitcodeFiles();
+
 llvm::Value* GenerateInlineLanguage(InlineCodeNode* ICN, AeroIR* IR, FunctionSymbols& Methods);
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "LoopHintGenerator.hh"
+
+static bool ParseHintCount(const AttributeSpec& Attr, const std::string& Text, unsigned Limit, bool PowerOfTwo, unsigned& Count) {
+    std::string Location = " at line " + std::to_string(Attr.token.line) + ", column " + std::to_string(Attr.token.column);
+    if (Text.empty() || Text.find_first_not_of("0123456789") != std::string::npos || Text.size() > 9) {
+        Write("Loop Hints", "'@" + Attr.name + "' expects a count, got '" + Text + "'" + Location, 2, true, true, "");
+        return false;
+    }
+    Count = std::stoul(Text);
+    if (Count == 0 || Count > Limit || (PowerOfTwo && (Count & (Count - 1)))) {
+        Write("Loop Hints", "'@" + Attr.name + "' count must be " + std::string(PowerOfTwo ? "a power of two " : "") +
+              "between 1 and " + std::to_string(Limit) + ", got " + Text + Location, 2, true, true, "");
+        return false;
+    }
+    return true;
+}
+
+llvm::MDNode* LoopHintsFromAttributes(const std::vector<AttributeSpec>& Attributes, AeroIR* IR) {
+    if (Attributes.empty()) {
+        return nullptr;
+    }
+
+    llvm::LLVMContext& Context = *IR->getContext();
+    std::vector<llvm::Metadata*> Hints;
+    std::set<std::string> Seen;
+
+    auto Flag = [&](const std::string& Name, bool Value) {
+        Hints.push_back(llvm::MDNode::get(Context, {llvm::MDString::get(Context, Name),
+                        llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(llvm::Type::getInt1Ty(Context), Value))}));
+    };
+    auto Count = [&](const std::string& Name, unsigned Value) {
+        Hints.push_back(llvm::MDNode::get(Context, {llvm::MDString::get(Context, Name),
+                        llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(llvm::Type::getInt32Ty(Context), Value))}));
+    };
+    auto Marker = [&](const std::string& Name) {
+        Hints.push_back(llvm::MDNode::get(Context, {llvm::MDString::get(Context, Name)}));
+    };
+
+    for (const auto& Attr : Attributes) {
+        std::string Location = " at line " + std::to_string(Attr.token.line) + ", column " + std::to_string(Attr.token.column);
+        if (!Seen.insert(Attr.name).second) {
+            Write("Loop Hints", "Duplicate attribute '@" + Attr.name + "' on loop" + Location, 2, true, true, "");
+            return nullptr;
+        }
+
+        if (Attr.name == "vectorize") {
+            Flag("llvm.loop.vectorize.enable", true);
+            for (const auto& Arg : Attr.args) {
+                // @vectorize(8) is shorthand for @vectorize(width=8)
+                std::string Key = Arg.find('=') == std::string::npos ? "width" : Arg.substr(0, Arg.find('='));
+                std::string Value = Arg.substr(Arg.find('=') == std::string::npos ? 0 : Arg.find('=') + 1);
+                unsigned Width = 0;
+                if (Key == "width") {
+                    if (!ParseHintCount(Attr, Value, 64, true, Width)) {
+                        return nullptr;
+                    }
+                    Count("llvm.loop.vectorize.width", Width);
+                } else if (Key == "scalable") {
+                    Flag("llvm.loop.vectorize.scalable.enable", Value == "true");
+                } else if (Key == "predicate") {
+                    Flag("llvm.loop.vectorize.predicate.enable", Value == "true");
+                } else {
+                    Write("Loop Hints", "Unknown '@vectorize' option '" + Key + "'" + Location, 2, true, true, "");
+                    return nullptr;
+                }
+            }
+        } else if (Attr.name == "novectorize") {
+            Flag("llvm.loop.vectorize.enable", false);
+        } else if (Attr.name == "unroll") {
+            unsigned Factor = 0;
+            if (Attr.args.size() > 1) {
+                Write("Loop Hints", "'@unroll' takes at most one count" + Location, 2, true, true, "");
+                return nullptr;
+            }
+            if (Attr.args.empty()) {
+                Marker("llvm.loop.unroll.enable");
+            } else if (Attr.args[0] == "full") {
+                Marker("llvm.loop.unroll.full");
+            } else if (ParseHintCount(Attr, Attr.args[0], 1024, false, Factor)) {
+                Count("llvm.loop.unroll.count", Factor);
+            } else {
+                return nullptr;
+            }
+        } else if (Attr.name == "nounroll") {
+            Marker("llvm.loop.unroll.disable");
+        } else if (Attr.name == "interleave") {
+            unsigned Factor = 0;
+            if (Attr.args.size() != 1) {
+                Write("Loop Hints", "'@interleave' takes exactly one count" + Location, 2, true, true, "");
+                return nullptr;
+            }
+            if (!ParseHintCount(Attr, Attr.args[0], 16, true, Factor)) {
+                return nullptr;
+            }
+            Count("llvm.loop.interleave.count", Factor);
+        } else if (Attr.name == "distribute") {
+            Flag("llvm.loop.distribute.enable", true);
+        } else {
+            Write("Loop Hints", "Unknown loop attribute '@" + Attr.name + "'" + Location, 2, true, true, "");
+            return nullptr;
+        }
+
+        if ((Attr.name == "novectorize" || Attr.name == "nounroll" || Attr.name == "distribute") && !Attr.args.empty()) {
+            Write("Loop Hints", "Attribute '@" + Attr.name + "' takes no arguments" + Location, 2, true, true, "");
+            return nullptr;
+        }
+    }
+
+    if ((Seen.count("vectorize") && Seen.count("novectorize")) || (Seen.count("unroll") && Seen.count("nounroll"))) {
+        Write("Loop Hints", "Conflicting loop attributes at line " + std::to_string(Attributes.front().token.line), 2, true, true, "");
+        return nullptr;
+    }
+
+    // a loop ID is distinct and refers to itself first
+    Hints.insert(Hints.begin(), nullptr);
+    llvm::MDNode* LoopID = llvm::MDNode::getDistinct(Context, Hints);
+    LoopID->replaceOperandWith(0, LoopID);
+    return LoopID;
+}
+
+void AttachLoopHints(llvm::MDNode* Hints, llvm::Value* Latch, const Token& LoopToken) {
+    if (!Hints) {
+        return;
+    }
+    auto* Branch = llvm::dyn_cast_or_null<llvm::BranchInst>(Latch);
+    if (!Branch) {
+        Write("Loop Hints", "Loop at line " + std::to_string(LoopToken.line) + " never repeats; its attributes are ignored", 1, true, true, "");
+        return;
+    }
+    Branch->setMetadata(llvm::LLVMContext::MD_loop, Hints);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../Helper/Types.hh"
+#include "../LLVMHeader.hh"
+
+// llvm.loop metadata for @vectorize / @novectorize / @unroll / @nounroll / @interleave / @distribute, nullptr when there are none
+llvm::MDNode* LoopHintsFromAttributes(const std::vector<AttributeSpec>& Attributes, AeroIR* IR);
+
+// attaches the hints to the back edge, or warns when the loop never reaches one
+void AttachLoopHints(llvm::MDNode* Hints, llvm::Value* Latch, const Token& LoopToken);
@@ -0,0 +1,216 @@
+#include "MatchGenerator.hh"
+#include "ExpressionGenerator.hh"
+#include "BlockGenerator.hh"
+
+#include <charconv>
+#include <string_view>
+
+static const uint64_t FNVOffset = 1469598103934665603ULL;
+static const uint64_t FNVPrime = 1099511628211ULL;
+
+static uint64_t HashLiteral(const std::string& Str) {
+    uint64_t Hash = FNVOffset;
+    for (unsigned char C : Str) {
+        Hash = (Hash ^ C) * FNVPrime;
+    }
+    return Hash;
+}
+
+// decimal or 0x-prefixed integer pattern with an optional leading '-'; anything else, such as a float, is invalid_argument
+static std::errc ParseIntegerPattern(const std::string& Text, bool& Negative, uint64_t& Magnitude) {
+    std::string_view Digits = Text;
+    Negative = !Digits.empty() && Digits.front() == '-';
+    if (Negative) Digits.remove_prefix(1);
+    int Base = 10;
+    if (Digits.size() > 2 && Digits[0] == '0' && (Digits[1] == 'x' || Digits[1] == 'X')) {
+        Base = 16;
+        Digits.remove_prefix(2);
+    }
+    auto [End, Error] = std::from_chars(Digits.data(), Digits.data() + Digits.size(), Magnitude, Base);
+    if (Error == std::errc() && End != Digits.data() + Digits.size()) return std::errc::invalid_argument;
+    return Error;
+}
+
+// FNV-1a over the first Length bytes of Str, matching HashLiteral
+static llvm::Value* EmitHash(llvm::Value* Str, llvm::Value* Length, AeroIR* IR) {
+    auto* Builder = IR->getBuilder();
+    llvm::BasicBlock* Entry = Builder->GetInsertBlock();
+    llvm::BasicBlock* Loop = IR->createBlock("match.hash");
+    llvm::BasicBlock* Body = IR->createBlock("match.hash.body");
+    llvm::BasicBlock* Done = IR->createBlock("match.hash.done");
+    IR->branch(Loop);
+
+    IR->setInsertPoint(Loop);
+    llvm::PHINode* Index = Builder->CreatePHI(IR->i64(), 2, "i");
+    llvm::PHINode* Hash = Builder->CreatePHI(IR->i64(), 2, "h");
+    Index->addIncoming(IR->constI64(0), Entry);
+    Hash->addIncoming(IR->constI64(FNVOffset), Entry);
+    IR->condBranch(Builder->CreateICmpULT(Index, Length), Body, Done);
+
+    IR->setInsertPoint(Body);
+    llvm::Value* Byte = Builder->CreateLoad(IR->i8(), Builder->CreateInBoundsGEP(IR->i8(), Str, Index));
+    llvm::Value* Next = Builder->CreateMul(Builder->CreateXor(Hash, Builder->CreateZExt(Byte, IR->i64())), IR->constI64(FNVPrime));
+    Index->addIncoming(Builder->CreateAdd(Index, IR->constI64(1), "", true, true), Body);
+    Hash->addIncoming(Next, Body);
+    IR->branch(Loop);
+
+    IR->setInsertPoint(Done);
+    return Hash;
+}
+
+static bool GenerateArm(const std::unique_ptr<BlockNode>& Block, llvm::BasicBlock* ArmBB, llvm::BasicBlock* EndBB, AeroIR* IR, FunctionSymbols& Methods) {
+    IR->setInsertPoint(ArmBB);
+    IR->pushScope();
+    GenerateBlock(Block, IR, Methods);
+    IR->popScope();
+    if (!IR->getBuilder()->GetInsertBlock()->getTerminator()) {
+        IR->branch(EndBB);
+        return true;
+    }
+    return false;
+}
+
+llvm::Value* GenerateMatch(MatchNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
+    if (!Node) {
+        Write("Match Generation", "Null MatchNode provided", 2, true, true, "");
+        return nullptr;
+    }
+
+    std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
+
+    llvm::Value* Subject = GenerateExpression(Node->subject, IR, Methods);
+    if (!Subject) {
+        Write("Match Generation", "Invalid match subject" + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Type* SubjectType = Subject->getType();
+    bool IsString = SubjectType->isPointerTy();
+    if (!IsString && !SubjectType->isIntegerTy()) {
+        Write("Match Generation", "Match subject must be an integer, character or string" + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::BasicBlock* EndBB = IR->createBlock("match.end");
+    llvm::BasicBlock* DefaultBB = Node->defaultBlock ? IR->createBlock("match.default") : EndBB;
+    std::vector<llvm::BasicBlock*> ArmBBs;
+    for (size_t i = 0; i < Node->arms.size(); ++i) {
+        ArmBBs.push_back(IR->createBlock("match.arm" + std::to_string(i)));
+    }
+
+    if (!IsString) {
+        llvm::SwitchInst* Switch = IR->getBuilder()->CreateSwitch(Subject, DefaultBB, Node->arms.size());
+        std::set<int64_t> Seen;
+        for (size_t i = 0; i < Node->arms.size(); ++i) {
+            for (const Token& Pattern : Node->arms[i].patterns) {
+                std::string PatternLocation = " at line " + std::to_string(Pattern.line) + ", column " + std::to_string(Pattern.column);
+                unsigned Bits = SubjectType->getIntegerBitWidth();
+                bool Negative = false;
+                uint64_t Magnitude = 0;
+                bool OutOfRange = false;
+                if (Pattern.type == TokenType::Character) {
+                    Magnitude = static_cast<unsigned char>(Pattern.value[0]);
+                } else if (Pattern.type == TokenType::Number) {
+                    std::errc Error = ParseIntegerPattern(Pattern.value, Negative, Magnitude);
+                    if (Error == std::errc::invalid_argument) {
+                        Write("Match Generation", "Pattern " + Pattern.value + " in a match over " + GetStringFromLLVMType(SubjectType) +
+                              " is not an integer" + PatternLocation, 2, true, true, "");
+                        return nullptr;
+                    }
+                    OutOfRange = Error == std::errc::result_out_of_range;
+                } else {
+                    Write("Match Generation", "String pattern \"" + Pattern.value + "\" in a match over " +
+                          GetStringFromLLVMType(SubjectType) + PatternLocation, 2, true, true, "");
+                    return nullptr;
+                }
+                // negative patterns reach down to the signed minimum, positive ones up to the unsigned maximum
+                uint64_t Limit = Negative ? uint64_t(1) << (Bits - 1) : (Bits < 64 ? (uint64_t(1) << Bits) - 1 : UINT64_MAX);
+                if (OutOfRange || Magnitude > Limit) {
+                    Write("Match Generation", "Pattern " + Pattern.value + " does not fit in " +
+                          GetStringFromLLVMType(SubjectType) + PatternLocation, 2, true, true, "");
+                    return nullptr;
+                }
+                int64_t Value = Negative ? static_cast<int64_t>(0 - Magnitude) : static_cast<int64_t>(Magnitude);
+                if (!Seen.insert(Bits < 64 ? Value & ((int64_t(1) << Bits) - 1) : Value).second) {
+                    Write("Match Generation", "Duplicate match pattern " + Pattern.value + PatternLocation, 2, true, true, "");
+                    return nullptr;
+                }
+                llvm::ConstantInt* Case = Value < 0 ? llvm::ConstantInt::getSigned(llvm::cast<llvm::IntegerType>(SubjectType), Value)
+                                                    : llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(SubjectType), Value);
+                Switch->addCase(Case, ArmBBs[i]);
+            }
+        }
+    } else {
+        // switch on length, then on a hash of the bytes, and confirm the hit with memcmp
+        std::map<uint64_t, std::vector<std::pair<std::string, size_t>>> ByLength;
+        std::set<std::string> Seen;
+        for (size_t i = 0; i < Node->arms.size(); ++i) {
+            for (const Token& Pattern : Node->arms[i].patterns) {
+                if (Pattern.type != TokenType::String) {
+                    Write("Match Generation", "Pattern " + Pattern.value + " in a match over strings at line " +
+                          std::to_string(Pattern.line) + ", column " + std::to_string(Pattern.column), 2, true, true, "");
+                    return nullptr;
+                }
+                if (!Seen.insert(Pattern.value).second) {
+                    Write("Match Generation", "Duplicate match pattern \"" + Pattern.value + "\" at line " +
+                          std::to_string(Pattern.line) + ", column " + std::to_string(Pattern.column), 2, true, true, "");
+                    return nullptr;
+                }
+                ByLength[Pattern.value.size()].push_back({Pattern.value, i});
+            }
+        }
+
+        llvm::Value* Length = IR->call(IR->runtimeFunction("strlen"), {Subject});
+        llvm::SwitchInst* LengthSwitch = IR->getBuilder()->CreateSwitch(Length, DefaultBB, ByLength.size());
+        llvm::Function* Memcmp = IR->runtimeFunction("memcmp");
+
+        auto EmitConfirm = [&](const std::string& Literal, size_t Arm, llvm::BasicBlock* Miss) {
+            llvm::Value* Cmp = IR->call(Memcmp, {Subject, IR->constString(Literal), IR->constI64(Literal.size())});
+            IR->condBranch(IR->eq(Cmp, IR->constI32(0)), ArmBBs[Arm], Miss);
+        };
+
+        for (const auto& [Len, Literals] : ByLength) {
+            llvm::BasicBlock* LengthBB = IR->createBlock("match.len" + std::to_string(Len));
+            LengthSwitch->addCase(llvm::cast<llvm::ConstantInt>(llvm::ConstantInt::get(IR->i64(), Len)), LengthBB);
+            IR->setInsertPoint(LengthBB);
+
+            if (Literals.size() == 1) {
+                EmitConfirm(Literals[0].first, Literals[0].second, DefaultBB);
+                continue;
+            }
+
+            std::map<uint64_t, std::vector<std::pair<std::string, size_t>>> ByHash;
+            for (const auto& Literal : Literals) {
+                ByHash[HashLiteral(Literal.first)].push_back(Literal);
+            }
+
+            llvm::Value* Hash = EmitHash(Subject, Length, IR);
+            llvm::SwitchInst* HashSwitch = IR->getBuilder()->CreateSwitch(Hash, DefaultBB, ByHash.size());
+            for (const auto& [HashValue, Colliding] : ByHash) {
+                llvm::BasicBlock* HashBB = IR->createBlock("match.hash.hit");
+                HashSwitch->addCase(llvm::cast<llvm::ConstantInt>(llvm::ConstantInt::get(IR->i64(), HashValue)), HashBB);
+                IR->setInsertPoint(HashBB);
+                for (size_t j = 0; j < Colliding.size(); ++j) {
+                    llvm::BasicBlock* Miss = j + 1 < Colliding.size() ? IR->createBlock("match.hash.next") : DefaultBB;
+                    EmitConfirm(Colliding[j].first, Colliding[j].second, Miss);
+                    IR->setInsertPoint(Miss);
+                }
+            }
+        }
+    }
+
+    bool EndReachable = !Node->defaultBlock;
+    for (size_t i = 0; i < Node->arms.size(); ++i) {
+        EndReachable |= GenerateArm(Node->arms[i].block, ArmBBs[i], EndBB, IR, Methods);
+    }
+    if (Node->defaultBlock) {
+        EndReachable |= GenerateArm(Node->defaultBlock, DefaultBB, EndBB, IR, Methods);
+    }
+
+    if (EndReachable) {
+        IR->setInsertPoint(EndBB);
+    } else {
+        EndBB->eraseFromParent();
+    }
+    return nullptr;
+}
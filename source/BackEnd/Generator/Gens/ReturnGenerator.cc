@@ -1,6 +1,78 @@
 #include "UnaryAssignmentGenerator.hh"
 #include "ExpressionGenerator.hh"
 
+#include <llvm/Analysis/CaptureTracking.h>
+#include <llvm/IR/InstIterator.h>
+
+// returned calls of the function being generated; whether they may be tail
+// called depends on every alloca in the caller, so it is settled at the end
+struct PendingTailCall {
+    llvm::CallInst* Call;
+    bool MustTail;
+    bool Become;
+    std::string Location;
+};
+static std::vector<PendingTailCall> PendingTailCalls;
+
+// why `Call` cannot be a musttail call from `Caller`, or empty if it can
+static std::string MustTailBlocker(llvm::CallInst* Call, llvm::Function* Caller) {
+    llvm::Function* Callee = Call->getCalledFunction();
+    if (!Callee) {
+        return "the call is indirect";
+    }
+    if (Callee->isIntrinsic()) {
+        return "'" + Callee->getName().str() + "' is an intrinsic";
+    }
+    if (Callee->isVarArg() || Caller->isVarArg()) {
+        return "variadic functions cannot be tail called";
+    }
+    if (Callee->getFunctionType() != Caller->getFunctionType()) {
+        return "'" + Callee->getName().str() + "' and '" + Caller->getName().str() + "' have different signatures";
+    }
+    if (Callee->getCallingConv() != Caller->getCallingConv()) {
+        return "calling conventions differ";
+    }
+    return "";
+}
+
+// a tail call (plain or musttail) promises the callee never touches the
+// caller's frame, which only holds while no alloca has escaped
+static bool FrameMayEscape(llvm::Function* Caller) {
+    for (llvm::Instruction& Inst : llvm::instructions(Caller)) {
+        if (auto* Alloca = llvm::dyn_cast<llvm::AllocaInst>(&Inst)) {
+            if (llvm::PointerMayBeCaptured(Alloca, /*ReturnCaptures=*/true)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool FinalizeTailCalls(llvm::Function* Caller) {
+    bool Escapes = FrameMayEscape(Caller);
+    bool Success = true;
+    for (const PendingTailCall& Pending : PendingTailCalls) {
+        if (Pending.Call->getFunction() != Caller) {
+            continue;
+        }
+        if (Escapes) {
+            if (Pending.Become) {
+                Write("Return Generator", "Cannot guarantee tail call: the address of a local in '" + Caller->getName().str() +
+                      "' escapes, so the callee could still reach its stack frame" + Pending.Location, 2, true, true, "");
+                Success = false;
+            }
+            continue;
+        }
+        if (Pending.MustTail) {
+            Pending.Call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+        } else {
+            Pending.Call->setTailCall();
+        }
+    }
+    std::erase_if(PendingTailCalls, [&](const PendingTailCall& Pending) { return Pending.Call->getFunction() == Caller; });
+    return Success;
+}
+
 llvm::Value* GenerateReturn(ReturnNode* Ret, AeroIR* IR, FunctionSymbols& Methods) { 
     if (!Ret) {
         Write("Return Generator", "Null ReturnNode pointer", 2, true, true, "");
@@ -26,6 +98,27 @@ llvm::Value* GenerateReturn(ReturnNode* Ret, AeroIR* IR, FunctionSymbols& Method
 
     llvm::Type* ReturnType = CurrentFunc->getReturnType();
 
+    // `ret f(...)` whose result is returned unchanged is a tail call; make it a
+    // guaranteed one (a jump, even at -O0) whenever the prototypes allow it.
+    // The marker itself is applied by FinalizeTailCalls once the body is complete
+    auto* TailCall = llvm::dyn_cast_or_null<llvm::CallInst>(Value);
+    if (TailCall && (Ret->value->type != NodeType::FunctionCall || TailCall != &IR->getBuilder()->GetInsertBlock()->back() ||
+                     TailCall->getType() != ReturnType)) {
+        TailCall = nullptr;
+    }
+    if (TailCall) {
+        std::string Blocker = MustTailBlocker(TailCall, CurrentFunc);
+        if (!Blocker.empty() && Ret->isBecome) {
+            Write("Return Generator", "Cannot guarantee tail call: " + Blocker + StmtLocation, 2, true, true, "");
+            return nullptr;
+        }
+        PendingTailCalls.push_back({TailCall, Blocker.empty(), Ret->isBecome, StmtLocation});
+        return IR->ret(TailCall->getType()->isVoidTy() ? nullptr : TailCall);
+    } else if (Ret->isBecome) {
+        Write("Return Generator", "Cannot guarantee tail call: the result of the call is converted before returning" + StmtLocation, 2, true, true, "");
+        return nullptr;
+    }
+
     if (Value) {
         if (Value->getType() != ReturnType) {
             if (ReturnType->isIntegerTy(1) && Value->getType()->isIntegerTy()) {
@@ -3,4 +3,7 @@
 #include "../Helper/Types.hh"
 #include "../LLVMHeader.hh"
 
-llvm::Value* GenerateReturn(ReturnNode* Ret, AeroIR* IR, FunctionSymbols& Methods);
\ No newline at end of file
+llvm::Value* GenerateReturn(ReturnNode* Ret, AeroIR* IR, FunctionSymbols& Methods);
+// marks the returned calls of `Caller` recorded by GenerateReturn as tail calls
+// if none of its allocas escape; false if a `become` could not be honoured
+bool FinalizeTailCalls(llvm::Function* Caller);
\ No newline at end of file
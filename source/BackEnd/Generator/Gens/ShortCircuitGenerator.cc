@@ -0,0 +1,86 @@
+#include "ShortCircuitGenerator.hh"
+
+// right-hand sides up to this size are evaluated unconditionally when that is safe
+static const unsigned SpeculationLimit = 4;
+
+static llvm::Value* ToBool(llvm::Value* Value, AeroIR* IR) {
+    llvm::Type* Type = Value->getType();
+    if (Type->isIntegerTy(1)) {
+        return Value;
+    } else if (Type->isFloatingPointTy()) {
+        return IR->getBuilder()->CreateFCmpONE(Value, llvm::ConstantFP::get(Type, 0.0));
+    } else if (Type->isIntegerTy()) {
+        return IR->ne(Value, llvm::ConstantInt::get(Type, 0));
+    } else if (Type->isPointerTy()) {
+        return IR->ne(Value, llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(Type)));
+    }
+    return nullptr;
+}
+
+bool IsSpeculatableBlock(llvm::BasicBlock* Block, unsigned Limit) {
+    if (Block->size() > Limit) {
+        return false;
+    }
+    for (auto& Inst : *Block) {
+        if (!llvm::isSafeToSpeculativelyExecute(&Inst)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+llvm::Value* GenerateShortCircuit(BinaryOpNode* Node, AeroIR* IR, FunctionSymbols& Methods, OperandGenerator Operand) {
+    bool IsAnd = Node->op == "&&";
+    std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
+
+    if (!Node->left || !Node->right) {
+        Write("Short Circuit", "Null operand for " + Node->op + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Value* Left = Operand(Node->left, IR, Methods);
+    Left = Left ? ToBool(Left, IR) : nullptr;
+    if (!Left) {
+        Write("Short Circuit", "Invalid left operand for " + Node->op + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::BasicBlock* LeftBB = IR->getBuilder()->GetInsertBlock();
+    llvm::BasicBlock* RightBB = IR->createBlock(IsAnd ? "land.rhs" : "lor.rhs");
+    llvm::BasicBlock* EndBB = IR->createBlock(IsAnd ? "land.end" : "lor.end");
+
+    if (IsAnd) {
+        IR->condBranch(Left, RightBB, EndBB);
+    } else {
+        IR->condBranch(Left, EndBB, RightBB);
+    }
+
+    IR->setInsertPoint(RightBB);
+    llvm::Value* Right = Operand(Node->right, IR, Methods);
+    Right = Right ? ToBool(Right, IR) : nullptr;
+    if (!Right) {
+        Write("Short Circuit", "Invalid right operand for " + Node->op + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    // a cheap, trap-free right side (compares of locals and constants) is hoisted
+    // into the left block so the whole expression stays branch-free
+    if (IR->getBuilder()->GetInsertBlock() == RightBB && IsSpeculatableBlock(RightBB, SpeculationLimit)) {
+        LeftBB->getTerminator()->eraseFromParent();
+        LeftBB->splice(LeftBB->end(), RightBB);
+        RightBB->eraseFromParent();
+        EndBB->eraseFromParent();
+        IR->setInsertPoint(LeftBB);
+        return IsAnd ? IR->getBuilder()->CreateLogicalAnd(Left, Right, "land")
+                     : IR->getBuilder()->CreateLogicalOr(Left, Right, "lor");
+    }
+
+    IR->branch(EndBB);
+    RightBB = IR->getBuilder()->GetInsertBlock();
+
+    IR->setInsertPoint(EndBB);
+    llvm::PHINode* Phi = IR->getBuilder()->CreatePHI(IR->bool_t(), 2, IsAnd ? "land" : "lor");
+    Phi->addIncoming(IR->constBool(!IsAnd), LeftBB);
+    Phi->addIncoming(Right, RightBB);
+    return Phi;
+}
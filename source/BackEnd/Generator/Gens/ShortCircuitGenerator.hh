@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../Helper/Types.hh"
+#include "../LLVMHeader.hh"
+
+typedef llvm::Value* (*OperandGenerator)(const std::unique_ptr<ASTNode>&, AeroIR*, FunctionSymbols&);
+
+bool IsSpeculatableBlock(llvm::BasicBlock* Block, unsigned Limit);
+llvm::Value* GenerateShortCircuit(BinaryOpNode* Node, AeroIR* IR, FunctionSymbols& Methods, OperandGenerator Operand);
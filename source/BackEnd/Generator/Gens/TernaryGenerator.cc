@@ -0,0 +1,99 @@
+#include "TernaryGenerator.hh"
+#include "ExpressionGenerator.hh"
+#include "ConditionGenerator.hh"
+#include "ShortCircuitGenerator.hh"
+
+// arms this small that cannot trap are computed unconditionally and joined with a select
+static const unsigned SelectArmLimit = 8;
+
+static llvm::Type* CommonArmType(llvm::Type* A, llvm::Type* B, AeroIR* IR) {
+    if (A == B) return A;
+    if (A->isFloatingPointTy() || B->isFloatingPointTy()) {
+        if (A->isPointerTy() || B->isPointerTy()) return nullptr;
+        return (A->isDoubleTy() || B->isDoubleTy()) ? IR->f64() : IR->f32();
+    }
+    if (A->isIntegerTy() && B->isIntegerTy()) {
+        return A->getIntegerBitWidth() > B->getIntegerBitWidth() ? A : B;
+    }
+    return nullptr;
+}
+
+static llvm::Value* ConvertArm(llvm::Value* Value, llvm::Type* Target, AeroIR* IR) {
+    llvm::Type* Source = Value->getType();
+    if (Source == Target) return Value;
+    if (Source->isIntegerTy() && Target->isFloatingPointTy()) {
+        return IR->getBuilder()->CreateSIToFP(Value, Target);
+    }
+    if (Source->isFloatingPointTy()) {
+        return IR->floatCast(Value, Target);
+    }
+    return IR->getBuilder()->CreateIntCast(Value, Target, !Source->isIntegerTy(1));
+}
+
+llvm::Value* GenerateTernary(TernaryNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
+    if (!Node || !Node->condition || !Node->thenExpr || !Node->elseExpr) {
+        Write("Ternary Generation", "Incomplete conditional expression", 2, true, true, "");
+        return nullptr;
+    }
+
+    std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
+
+    llvm::Value* Condition = GenerateConditionExpression(Node->condition, IR, Methods);
+    if (!Condition) {
+        Write("Ternary Generation", "Invalid condition" + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::BasicBlock* CondBB = IR->getBuilder()->GetInsertBlock();
+    llvm::BasicBlock* ThenBB = IR->createBlock("cond.true");
+    llvm::BasicBlock* ElseBB = IR->createBlock("cond.false");
+    llvm::BasicBlock* EndBB = IR->createBlock("cond.end");
+    IR->condBranch(Condition, ThenBB, ElseBB);
+
+    IR->setInsertPoint(ThenBB);
+    llvm::Value* ThenValue = GenerateExpression(Node->thenExpr, IR, Methods);
+    llvm::BasicBlock* ThenEnd = IR->getBuilder()->GetInsertBlock();
+
+    IR->setInsertPoint(ElseBB);
+    llvm::Value* ElseValue = GenerateExpression(Node->elseExpr, IR, Methods);
+    llvm::BasicBlock* ElseEnd = IR->getBuilder()->GetInsertBlock();
+
+    if (!ThenValue || !ElseValue) {
+        Write("Ternary Generation", "Invalid branch value" + Location, 2, true, true, "");
+        return nullptr;
+    }
+
+    llvm::Type* ResultType = CommonArmType(ThenValue->getType(), ElseValue->getType(), IR);
+    if (!ResultType) {
+        Write("Ternary Generation", "Branches have incompatible types " + GetStringFromLLVMType(ThenValue->getType()) +
+              " and " + GetStringFromLLVMType(ElseValue->getType()) + Location, 2, true, true, "");
+        return nullptr;
+    }
+    IR->setInsertPoint(ThenEnd);
+    ThenValue = ConvertArm(ThenValue, ResultType, IR);
+    IR->setInsertPoint(ElseEnd);
+    ElseValue = ConvertArm(ElseValue, ResultType, IR);
+
+    if (ThenEnd == ThenBB && ElseEnd == ElseBB &&
+        IsSpeculatableBlock(ThenBB, SelectArmLimit) && IsSpeculatableBlock(ElseBB, SelectArmLimit)) {
+        CondBB->getTerminator()->eraseFromParent();
+        CondBB->splice(CondBB->end(), ThenBB);
+        CondBB->splice(CondBB->end(), ElseBB);
+        ThenBB->eraseFromParent();
+        ElseBB->eraseFromParent();
+        EndBB->eraseFromParent();
+        IR->setInsertPoint(CondBB);
+        return IR->getBuilder()->CreateSelect(Condition, ThenValue, ElseValue, "cond");
+    }
+
+    IR->setInsertPoint(ThenEnd);
+    IR->branch(EndBB);
+    IR->setInsertPoint(ElseEnd);
+    IR->branch(EndBB);
+
+    IR->setInsertPoint(EndBB);
+    llvm::PHINode* Phi = IR->getBuilder()->CreatePHI(ResultType, 2, "cond");
+    Phi->addIncoming(ThenValue, ThenEnd);
+    Phi->addIncoming(ElseValue, ElseEnd);
+    return Phi;
+}
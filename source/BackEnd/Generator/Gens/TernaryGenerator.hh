@@ -0,0 +1,6 @@
+#pragma once
+
+#include "../Helper/Types.hh"
+#include "../LLVMHeader.hh"
+
+llvm::Value* GenerateTernary(TernaryNode* Node, AeroIR* IR, FunctionSymbols& Methods);
@@ -84,7 +84,7 @@ llvm::Value* GenerateUnaryAssignment(UnaryOpNode* UnaryOp, AeroIR* IR, FunctionS
                 }
                 
                 elementType = currentType;
-                elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
             } else {
                 llvm::Value* indexValue = GenerateExpression(ArrayAccess->expr, IR, Methods);
                 if (!indexValue || !indexValue->getType()->isIntegerTy()) {
@@ -118,7 +118,7 @@ llvm::Value* GenerateUnaryAssignment(UnaryOpNode* UnaryOp, AeroIR* IR, FunctionS
                     indexValue
                 };
                 
-                elementPtr = IR->getBuilder()->CreateInBoundsGEP(allocatedType, arrayPtr, indices);
+                elementPtr = IR->elementPtr(allocatedType, arrayPtr, indices);
             }
         }
         
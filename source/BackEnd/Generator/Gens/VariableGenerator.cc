@@ -3,6 +3,28 @@
 #include <iostream>
 #include <cmath>
 
+// @align(N) is the only variable attribute; returns 0 when absent, -1 on error
+static long VariableAlignment(VariableNode* Node, const std::string& Location) {
+    long Alignment = 0;
+    for (const auto& Attr : Node->attributes) {
+        if (Attr.name != "align") {
+            Write("Variable Generation", "Unknown attribute '@" + Attr.name + "' on variable " + Node->name + Location, 2, true, true, "");
+            return -1;
+        }
+        if (Attr.args.size() != 1) {
+            Write("Variable Generation", "'@align' takes exactly one argument" + Location, 2, true, true, "");
+            return -1;
+        }
+        char* End = nullptr;
+        Alignment = std::strtol(Attr.args[0].c_str(), &End, 10);
+        if (*End != '\0' || Alignment <= 0 || (Alignment & (Alignment - 1)) != 0 || Alignment > 65536) {
+            Write("Variable Generation", "'@align' needs a power of two up to 65536, got '" + Attr.args[0] + "'" + Location, 2, true, true, "");
+            return -1;
+        }
+    }
+    return Alignment;
+}
+
 void GenerateVariable(VariableNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Node) {
         Write("Variable Generation", "Null VariableNode provided", 2, true, true, "");
@@ -13,6 +35,11 @@ void GenerateVariable(VariableNode* Node, AeroIR* IR, FunctionSymbols& Methods)
     std::string Type = Node->varType.name;
     std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
 
+    long Alignment = VariableAlignment(Node, Location);
+    if (Alignment < 0) {
+        return;
+    }
+
     llvm::Type* BaseType = nullptr;
     bool isArray = false;
     
@@ -67,6 +94,11 @@ void GenerateVariable(VariableNode* Node, AeroIR* IR, FunctionSymbols& Methods)
 
     llvm::Value* AllocaInst = nullptr;
 
+    if (Alignment && (!isArray || (!Node->arrayExpression && !(Node->value && Node->value->type == NodeType::Array)))) {
+        Write("Variable Generation", "'@align' only applies to sized array declarations: " + Name + Location, 2, true, true, "");
+        return;
+    }
+
     if (isArray) {
         if (Node->value && Node->value->type == NodeType::Array) {
             ArrayNode* arrayLiteral = static_cast<ArrayNode*>(Node->value.get());
@@ -122,9 +154,12 @@ void GenerateVariable(VariableNode* Node, AeroIR* IR, FunctionSymbols& Methods)
                 return;
             }
             
-            AllocaInst = IR->heapArray(Name, BaseType, sizeValue);
+            AllocaInst = IR->heapArray(Name, BaseType, sizeValue, Alignment);
         } else {
             AllocaInst = IR->var(Name, IR->ptr(BaseType));
+            if (Type.find("[][]") == std::string::npos) {
+                IR->setArrayElementType(AllocaInst, BaseType);
+            }
             
             if (Node->value) {
                 llvm::Value* Value = GenerateExpression(Node->value, IR, Methods);
@@ -190,4 +225,8 @@ void GenerateVariable(VariableNode* Node, AeroIR* IR, FunctionSymbols& Methods)
         Write("Variable Generation", "Failed to create variable: " + Name + Location, 2, true, true, "");
         return;
     }
+
+    if (auto* Alloca = llvm::dyn_cast<llvm::AllocaInst>(AllocaInst); Alloca && Alignment) {
+        Alloca->setAlignment(std::max(Alloca->getAlign(), llvm::Align(Alignment)));
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "BlockGenerator.hh"
 #include "ConditionGenerator.hh"
 #include "BreakGenerator.hh"
+#include "LoopHintGenerator.hh"
 
 llvm::Value* GenerateWhile(WhileNode* Node, AeroIR* IR, FunctionSymbols& Methods) {
     if (!Node) {
@@ -11,6 +12,11 @@ llvm::Value* GenerateWhile(WhileNode* Node, AeroIR* IR, FunctionSymbols& Methods
 
     std::string Location = " at line " + std::to_string(Node->token.line) + ", column " + std::to_string(Node->token.column);
 
+    llvm::MDNode* Hints = LoopHintsFromAttributes(Node->attributes, IR);
+    if (!Node->attributes.empty() && !Hints) {
+        return nullptr;
+    }
+
     llvm::BasicBlock* LoopHeader = IR->createBlock("while.header");
     llvm::BasicBlock* LoopBody = IR->createBlock("while.body");
     llvm::BasicBlock* LoopExit = IR->createBlock("while.exit");
@@ -24,17 +30,20 @@ llvm::Value* GenerateWhile(WhileNode* Node, AeroIR* IR, FunctionSymbols& Methods
         return nullptr;
     }
 
-    IR->condBranch(Condition, LoopBody, LoopExit);
+    IR->condBranch(Condition, LoopBody, LoopExit, Node->condition->likelihood);
 
     IR->setInsertPoint(LoopBody);
     LoopExitStack.push(LoopExit);
     GenerateBlock(Node->block, IR, Methods);
     LoopExitStack.pop();
 
+    IR->setSourceLocation(Node->token.line, Node->token.column);
     llvm::BasicBlock* currentBlock = IR->getBuilder()->GetInsertBlock();
+    llvm::Value* Latch = nullptr;
     if (!currentBlock->getTerminator()) {
-        IR->branch(LoopHeader);
+        Latch = IR->branch(LoopHeader);
     }
+    AttachLoopHints(Hints, Latch, Node->token);
 
     IR->setInsertPoint(LoopExit);
     return IR->constI32(0);
@@ -1,8 +1,11 @@
 #include "ModuleAnalyser.hh"
 #include "../../Miscellaneous/LoggerHandler/ColorPrint.hh"
+#include "../../FrontEnd/Tokenizer.hh"
 
 #include <fstream>
 #include <cstdlib>
+#include <iomanip>
+#include <sstream>
 
 void PrintSectionHeader(const std::string& title) {
     PrintRGB("\n", 0, 0, 0);
@@ -85,6 +88,24 @@ void ModuleAnalyzer::AnalyzeSymbols() {
             case llvm::GlobalValue::PrivateLinkage: details += "private"; break;
             default: details += "other"; break;
         }
+
+        if (F.getCallingConv() == llvm::CallingConv::Fast) {
+            details += " cc=fast";
+        }
+
+        std::string attrs;
+        if (F.hasFnAttribute(llvm::Attribute::AlwaysInline)) attrs += " always_inline";
+        if (F.hasFnAttribute(llvm::Attribute::InlineHint)) attrs += " inline";
+        if (F.hasFnAttribute(llvm::Attribute::NoInline)) attrs += " noinline";
+        if (F.hasFnAttribute(llvm::Attribute::Hot)) attrs += " hot";
+        if (F.hasFnAttribute(llvm::Attribute::Cold)) attrs += " cold";
+        if (F.hasFnAttribute(llvm::Attribute::MinSize)) attrs += " minsize";
+        if (F.hasFnAttribute(llvm::Attribute::OptimizeNone)) attrs += " optnone";
+        if (F.doesNotAccessMemory()) attrs += " memory(none)";
+        else if (F.onlyReadsMemory()) attrs += " memory(read)";
+        if (!attrs.empty()) {
+            details += " attrs=" + attrs.substr(1);
+        }
         
         PrintTreeItem(prefix, name, details);
     }
@@ -400,94 +421,448 @@ void ModuleAnalyzer::RunFullAnalysis() {
     AnalyzeMemoryUsage();
 }
 
+RemarkCollector::RemarkCollector(std::vector<OptimisationRemark>& Out, const std::string& Filter, const fs::path& Input)
+    : Remarks(Out), PassFilter(Filter), Collecting(!Filter.empty()), InputFile(Input) {}
+
+bool RemarkCollector::isAnalysisRemarkEnabled(llvm::StringRef PassName) const {
+    return Collecting && PassFilter.match(PassName);
+}
+
+bool RemarkCollector::isMissedOptRemarkEnabled(llvm::StringRef PassName) const {
+    return Collecting && PassFilter.match(PassName);
+}
+
+bool RemarkCollector::isPassedOptRemarkEnabled(llvm::StringRef PassName) const {
+    return Collecting && PassFilter.match(PassName);
+}
+
+bool RemarkCollector::isAnyRemarkEnabled() const {
+    return Collecting;
+}
+
+bool RemarkCollector::handleDiagnostics(const llvm::DiagnosticInfo& DI) {
+    auto* Remark = llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&DI);
+    if (!Remark) {
+        return false;
+    }
+
+    if (!Remark->isEnabled()) {
+        return true;
+    }
+
+    OptimisationRemark Entry;
+    if (llvm::isa<llvm::DiagnosticInfoOptimizationFailure>(Remark)) {
+        Entry.Kind = "Failure";
+    } else if (!Collecting) {
+        return true;
+    } else if (llvm::isa<llvm::OptimizationRemark>(Remark)) {
+        Entry.Kind = "Passed";
+    } else if (llvm::isa<llvm::OptimizationRemarkMissed>(Remark)) {
+        Entry.Kind = "Missed";
+    } else {
+        Entry.Kind = "Analysis";
+    }
+
+    Entry.Pass = Remark->getPassName().str();
+    Entry.Name = Remark->getRemarkName().str();
+    Entry.Function = Remark->getFunction().getName().str();
+    Entry.Message = Remark->getMsg();
+    Entry.File = InputFile.filename().string();
+
+    if (Remark->isLocationAvailable()) {
+        llvm::StringRef RelativePath;
+        Remark->getLocation(RelativePath, Entry.Line, Entry.Column);
+
+        auto Origin = SourceLineOrigins.find(Entry.Line);
+        if (Origin != SourceLineOrigins.end()) {
+            if (!Origin->second.first.empty()) {
+                Entry.File = Origin->second.first;
+            }
+            Entry.Line = Origin->second.second;
+        }
+    }
+
+    Remarks.push_back(Entry);
+    return true;
+}
+
+RemarkAnalyzer::RemarkAnalyzer(const std::vector<OptimisationRemark>& R) : Remarks(R) {}
+
+void RemarkAnalyzer::PrintRemarkReport() {
+    PrintSectionHeader("Optimisation Remarks");
+
+    if (Remarks.empty()) {
+        PrintRGB("  no remarks were emitted (try -O2 or higher)\n", 150, 150, 150);
+        return;
+    }
+
+    std::vector<const OptimisationRemark*> Sorted;
+    for (const auto& R : Remarks) {
+        Sorted.push_back(&R);
+    }
+    std::stable_sort(Sorted.begin(), Sorted.end(), [](const OptimisationRemark* A, const OptimisationRemark* B) {
+        if (A->File != B->File) return A->File < B->File;
+        if (A->Line != B->Line) return A->Line < B->Line;
+        return A->Column < B->Column;
+    });
+
+    std::map<std::string, std::map<std::string, size_t>> Summary;
+
+    for (const auto* R : Sorted) {
+        PrintRGB("|-", 150, 150, 150);
+        if (R->Line) {
+            PrintRGB(R->File + ":" + std::to_string(R->Line) + ":" + std::to_string(R->Column) + " ", 255, 255, 255);
+        } else {
+            PrintRGB(R->File + ":<unknown> ", 255, 255, 255);
+        }
+
+        if (R->Kind == "Passed") {
+            PrintRGB("[passed] ", 100, 255, 100);
+        } else if (R->Kind == "Missed") {
+            PrintRGB("[missed] ", 255, 100, 100);
+        } else if (R->Kind == "Failure") {
+            PrintRGB("[failed] ", 255, 60, 60);
+        } else {
+            PrintRGB("[analysis] ", 255, 255, 0);
+        }
+
+        PrintRGB(R->Pass, 200, 200, 255);
+        PrintRGB(" in ", 150, 150, 150);
+        PrintRGB(R->Function, 255, 200, 100);
+        std::cout << "\n";
+
+        PrintTreeItem("  |-", R->Message);
+        Summary[R->Pass][R->Kind]++;
+    }
+
+    PrintSectionHeader("Remark Summary");
+    for (const auto& [Pass, Kinds] : Summary) {
+        std::string Details;
+        for (const auto& [Kind, Count] : Kinds) {
+            if (!Details.empty()) Details += ", ";
+            Details += Kind + "=" + std::to_string(Count);
+        }
+        PrintAttribute(Pass, Details, Kinds.count("Missed") > 0 || Kinds.count("Failure") > 0);
+    }
+}
+
+bool RemarkAnalyzer::WriteRemarkFile(const fs::path& Path) {
+    std::ofstream Out(Path);
+    if (!Out.is_open()) {
+        return false;
+    }
+
+    std::string Extension = Path.extension().string();
+    std::transform(Extension.begin(), Extension.end(), Extension.begin(), ::tolower);
+
+    if (Extension == ".json") {
+        auto Escape = [](const std::string& S) {
+            std::string Result;
+            for (char C : S) {
+                switch (C) {
+                    case '"': Result += "\\\""; break;
+                    case '\\': Result += "\\\\"; break;
+                    case '\n': Result += "\\n"; break;
+                    case '\t': Result += "\\t"; break;
+                    default: Result += C; break;
+                }
+            }
+            return Result;
+        };
+
+        Out << "[\n";
+        for (size_t i = 0; i < Remarks.size(); ++i) {
+            const auto& R = Remarks[i];
+            Out << "  {\"kind\": \"" << R.Kind << "\", "
+                << "\"pass\": \"" << Escape(R.Pass) << "\", "
+                << "\"name\": \"" << Escape(R.Name) << "\", "
+                << "\"function\": \"" << Escape(R.Function) << "\", "
+                << "\"file\": \"" << Escape(R.File) << "\", "
+                << "\"line\": " << R.Line << ", "
+                << "\"column\": " << R.Column << ", "
+                << "\"message\": \"" << Escape(R.Message) << "\"}"
+                << (i + 1 < Remarks.size() ? ",\n" : "\n");
+        }
+        Out << "]\n";
+        return true;
+    }
+
+    auto Quote = [](const std::string& S) {
+        std::string Result = "'";
+        for (char C : S) {
+            if (C == '\'') Result += "''";
+            else if (C == '\n') Result += ' ';
+            else Result += C;
+        }
+        return Result + "'";
+    };
+
+    for (const auto& R : Remarks) {
+        Out << "--- !" << R.Kind << "\n";
+        Out << "Pass:            " << R.Pass << "\n";
+        Out << "Name:            " << R.Name << "\n";
+        if (R.Line) {
+            Out << "DebugLoc:        { File: " << Quote(R.File) << ", Line: " << R.Line << ", Column: " << R.Column << " }\n";
+        }
+        Out << "Function:        " << Quote(R.Function) << "\n";
+        Out << "Message:         " << Quote(R.Message) << "\n";
+        Out << "...\n";
+    }
+    return true;
+}
+
 void AnalyzeGeneratedCode(llvm::Module* Module) {
     ModuleAnalyzer Analyzer(Module);
     Analyzer.RunFullAnalysis();
 }
 
-NativeAssemblyAnalyzer::NativeAssemblyAnalyzer(llvm::Module* M) : Module(M), TargetMachine(nullptr) {
-    int result = system("llc --version >nul 2>&1");
-    this->HasLLC = (result == 0);
-    
-    if (!this->HasLLC) {
-        result = system("llc --version >/dev/null 2>&1");
-        this->HasLLC = (result == 0);
+NativeAssemblyAnalyzer::NativeAssemblyAnalyzer(llvm::Module* M, const std::string& Triple, const std::string& CPUName, const std::string& FeatureString) : Module(M), TargetMachine(nullptr) {
+    std::string Error;
+    this->TargetTriple = Triple;
+    if (this->TargetTriple.empty() || !llvm::TargetRegistry::lookupTarget(this->TargetTriple, Error)) {
+        this->TargetTriple = llvm::sys::getDefaultTargetTriple();
     }
-    
-    if (this->HasLLC) {
-        PrintRGB("info: ", 100, 255, 100);
-        PrintRGB("found llc compiler, native assembly generation available\n", 200, 200, 200);
-    } else {
-        PrintRGB("info: ", 255, 255, 0);
-        PrintRGB("llc compiler not found, native assembly generation disabled\n", 200, 200, 200);
+
+    this->CPU = CPUName;
+    this->Features = FeatureString;
+    if (this->CPU.empty()) {
+        this->CPU = (this->TargetTriple == llvm::sys::getDefaultTargetTriple()) ? llvm::sys::getHostCPUName().str() : "generic";
+    }
+
+    const llvm::Target* Target = llvm::TargetRegistry::lookupTarget(this->TargetTriple, Error);
+    if (!Target) {
+        PrintRGB("error: ", 255, 0, 0);
+        PrintRGB("no target available for " + this->TargetTriple + ": " + Error + "\n", 200, 100, 100);
+        return;
     }
+
+    llvm::TargetOptions Options;
+    this->TargetMachine = Target->createTargetMachine(llvm::Triple(this->TargetTriple), this->CPU, this->Features, Options, std::nullopt);
+}
+
+static std::string FormatCycles(double Value) {
+    std::ostringstream Out;
+    Out << std::fixed << std::setprecision(2) << Value;
+    return Out.str();
+}
+
+static std::string FormatAddress(uint64_t Address) {
+    std::ostringstream Out;
+    Out << std::hex << std::setw(6) << std::setfill('0') << Address;
+    return Out.str();
+}
+
+void NativeAssemblyAnalyzer::PrintLoopThroughput(const std::vector<std::pair<uint64_t, llvm::MCInst>>& Body, uint64_t Start, uint64_t End) {
+    const llvm::MCSubtargetInfo& STI = *this->TargetMachine->getMCSubtargetInfo();
+    const llvm::MCInstrInfo& MII = *this->TargetMachine->getMCInstrInfo();
+    const llvm::MCSchedModel& SM = STI.getSchedModel();
+
+    PrintRGB("  |-", 150, 150, 150);
+    PrintRGB("loop 0x" + FormatAddress(Start) + "-0x" + FormatAddress(End), 255, 200, 100);
+    PrintRGB(" (" + std::to_string(Body.size()) + " instructions)\n", 150, 150, 150);
+
+    if (!SM.hasInstrSchedModel()) {
+        PrintRGB("    note: ", 255, 255, 0);
+        PrintRGB("no scheduling model for cpu '" + this->CPU + "', throughput unavailable\n", 200, 200, 200);
+        return;
+    }
+
+    std::vector<double> Pressure(SM.getNumProcResourceKinds(), 0.0);
+    unsigned MicroOps = 0;
+
+    for (const auto& [Address, Inst] : Body) {
+        unsigned SchedClass = MII.get(Inst.getOpcode()).getSchedClass();
+        const llvm::MCSchedClassDesc* Desc = SM.getSchedClassDesc(SchedClass);
+        while (Desc && Desc->isVariant()) {
+            SchedClass = STI.resolveVariantSchedClass(SchedClass, &Inst, &MII, SM.getProcessorID());
+            Desc = SchedClass ? SM.getSchedClassDesc(SchedClass) : nullptr;
+        }
+        if (!Desc || !Desc->isValid()) continue;
+
+        MicroOps += Desc->NumMicroOps;
+        for (const auto* WPR = STI.getWriteProcResBegin(Desc); WPR != STI.getWriteProcResEnd(Desc); ++WPR) {
+            Pressure[WPR->ProcResourceIdx] += WPR->ReleaseAtCycle - WPR->AcquireAtCycle;
+        }
+    }
+
+    double Cycles = SM.IssueWidth ? static_cast<double>(MicroOps) / SM.IssueWidth : 0.0;
+    std::string Bottleneck = "dispatch width";
+    std::string Ports;
+
+    for (unsigned i = 1; i < SM.getNumProcResourceKinds(); ++i) {
+        if (Pressure[i] == 0.0) continue;
+
+        const llvm::MCProcResourceDesc* Resource = SM.getProcResource(i);
+        double Load = Pressure[i] / Resource->NumUnits;
+        if (Load > Cycles) {
+            Cycles = Load;
+            Bottleneck = Resource->Name;
+        }
+
+        if (!Resource->SubUnitsIdxBegin) {
+            Ports += std::string(Resource->Name) + "=" + FormatCycles(Load) + " ";
+        }
+    }
+
+    PrintAttribute("  Cycles/Iteration", FormatCycles(Cycles), true);
+    PrintAttribute("  uOps/Iteration", std::to_string(MicroOps));
+    PrintAttribute("  Dispatch Width", std::to_string(SM.IssueWidth));
+    PrintAttribute("  Bottleneck", Bottleneck, true);
+    PrintAttribute("  Port Pressure", Ports.empty() ? "none" : Ports);
 }
 
 void NativeAssemblyAnalyzer::PrintNativeAssembly() {
-    PrintSectionHeader("Native Assembly");
-    
-    if (!this->HasLLC) {
-        PrintRGB("info: ", 255, 255, 0);
-        PrintRGB("native assembly generation requires 'llc' tool\n", 200, 200, 200);
-        PrintRGB("note: ", 150, 150, 150);
-        PrintRGB("install LLVM tools or add llc to PATH\n", 200, 200, 200);
+    PrintSectionHeader("Native Assembly (" + this->TargetTriple + ", " + this->CPU + ")");
+
+    if (!this->TargetMachine) {
+        PrintRGB("error: ", 255, 0, 0);
+        PrintRGB("failed to create target machine\n", 200, 100, 100);
         return;
     }
-    
-    std::string TempBC = "temp_module.bc";
-    std::string TempASM = "temp_module.s";
-    
-    std::error_code EC;
-    llvm::raw_fd_ostream BCFile(TempBC, EC);
-    if (EC) {
+
+    std::unique_ptr<llvm::Module> Clone = llvm::CloneModule(*Module);
+    Clone->setTargetTriple(this->TargetMachine->getTargetTriple());
+    Clone->setDataLayout(this->TargetMachine->createDataLayout());
+
+    llvm::SmallVector<char, 0> ObjectBuffer;
+    llvm::raw_svector_ostream ObjectStream(ObjectBuffer);
+    llvm::legacy::PassManager PM;
+    if (this->TargetMachine->addPassesToEmitFile(PM, ObjectStream, nullptr, llvm::CodeGenFileType::ObjectFile)) {
         PrintRGB("error: ", 255, 0, 0);
-        PrintRGB("failed to create temporary file\n", 200, 100, 100);
+        PrintRGB("target cannot emit object code\n", 200, 100, 100);
         return;
     }
-    
-    llvm::WriteBitcodeToFile(*Module, BCFile);
-    BCFile.close();
-    
-    std::string Command = "llc -filetype=asm " + TempBC + " -o " + TempASM;
-    int Result = system(Command.c_str());
-    
-    if (Result != 0) {
+    PM.run(*Clone);
+
+    llvm::MemoryBufferRef ObjectRef(llvm::StringRef(ObjectBuffer.data(), ObjectBuffer.size()), Module->getName());
+    auto ObjectOrErr = llvm::object::ObjectFile::createObjectFile(ObjectRef);
+    if (!ObjectOrErr) {
+        llvm::consumeError(ObjectOrErr.takeError());
         PrintRGB("error: ", 255, 0, 0);
-        PrintRGB("llc failed to generate assembly\n", 200, 100, 100);
-        remove(TempBC.c_str());
+        PrintRGB("failed to read generated object code\n", 200, 100, 100);
         return;
     }
-    
-    std::ifstream ASMFile(TempASM);
-    if (!ASMFile.is_open()) {
+    llvm::object::ObjectFile& Object = **ObjectOrErr;
+
+    const llvm::Target& Target = this->TargetMachine->getTarget();
+    const llvm::MCSubtargetInfo& STI = *this->TargetMachine->getMCSubtargetInfo();
+    const llvm::MCInstrInfo& MII = *this->TargetMachine->getMCInstrInfo();
+    const llvm::MCRegisterInfo& MRI = *this->TargetMachine->getMCRegisterInfo();
+    const llvm::MCAsmInfo& MAI = *this->TargetMachine->getMCAsmInfo();
+
+    llvm::MCContext Ctx(this->TargetMachine->getTargetTriple(), &MAI, &MRI, &STI);
+    std::unique_ptr<llvm::MCDisassembler> Disassembler(Target.createMCDisassembler(STI, Ctx));
+    std::unique_ptr<llvm::MCInstPrinter> Printer(Target.createMCInstPrinter(this->TargetMachine->getTargetTriple(), MAI.getAssemblerDialect(), MAI, MII, MRI));
+    std::unique_ptr<llvm::MCInstrAnalysis> Analysis(Target.createMCInstrAnalysis(&MII));
+
+    if (!Disassembler || !Printer) {
         PrintRGB("error: ", 255, 0, 0);
-        PrintRGB("failed to read generated assembly\n", 200, 100, 100);
-        remove(TempBC.c_str());
-        remove(TempASM.c_str());
+        PrintRGB("no disassembler available for " + this->TargetTriple + "\n", 200, 100, 100);
         return;
     }
-    
-    std::string line;
-    while (std::getline(ASMFile, line)) {
-        if (line.empty()) continue;
-        
-        if (line[0] == '.') {
-            PrintRGB(line, 100, 200, 255);
-        } else if (line.find(':') != std::string::npos && line[0] != '\t' && line[0] != ' ') {
-            PrintRGB(line, 255, 255, 100);
-        } else if (line[0] == '\t' || line[0] == ' ') {
-            PrintRGB(line, 200, 200, 200);
-        } else {
-            PrintRGB(line, 150, 150, 150);
+
+    struct FunctionRange {
+        std::string Name;
+        llvm::object::SectionRef Section;
+        uint64_t Start;
+        uint64_t End;
+    };
+
+    std::vector<FunctionRange> Functions;
+    for (const auto& Symbol : Object.symbols()) {
+        auto Type = Symbol.getType();
+        auto Name = Symbol.getName();
+        auto Address = Symbol.getAddress();
+        auto Section = Symbol.getSection();
+        if (!Type || !Name || !Address || !Section) {
+            if (!Type) llvm::consumeError(Type.takeError());
+            if (!Name) llvm::consumeError(Name.takeError());
+            if (!Address) llvm::consumeError(Address.takeError());
+            if (!Section) llvm::consumeError(Section.takeError());
+            continue;
         }
-        std::cout << "\n";
+        if (*Type != llvm::object::SymbolRef::ST_Function || *Section == Object.section_end() || !(*Section)->isText()) continue;
+
+        Functions.push_back({Name->str(), **Section, *Address, (*Section)->getAddress() + (*Section)->getSize()});
     }
-    
-    ASMFile.close();
-    remove(TempBC.c_str());
-    remove(TempASM.c_str());
+
+    std::sort(Functions.begin(), Functions.end(), [](const FunctionRange& A, const FunctionRange& B) {
+        if (A.Section.getIndex() != B.Section.getIndex()) return A.Section.getIndex() < B.Section.getIndex();
+        return A.Start < B.Start;
+    });
+    for (size_t i = 0; i + 1 < Functions.size(); ++i) {
+        if (Functions[i].Section == Functions[i + 1].Section) {
+            Functions[i].End = Functions[i + 1].Start;
+        }
+    }
+
+    for (const auto& Function : Functions) {
+        auto Contents = Function.Section.getContents();
+        if (!Contents) {
+            llvm::consumeError(Contents.takeError());
+            continue;
+        }
+
+        uint64_t SectionStart = Function.Section.getAddress();
+        llvm::ArrayRef<uint8_t> Bytes(reinterpret_cast<const uint8_t*>(Contents->data()), Contents->size());
+
+        std::vector<std::pair<uint64_t, llvm::MCInst>> Instructions;
+        std::vector<std::pair<uint64_t, uint64_t>> Loops;
+
+        PrintRGB("\n" + Function.Name + ":\n", 255, 255, 100);
+
+        uint64_t Address = Function.Start;
+        while (Address < Function.End) {
+            llvm::MCInst Inst;
+            uint64_t Size = 0;
+            auto Status = Disassembler->getInstruction(Inst, Size, Bytes.slice(Address - SectionStart, Function.End - Address), Address, llvm::nulls());
+            if (Size == 0) Size = 1;
+
+            PrintRGB("  " + FormatAddress(Address) + ":", 150, 150, 150);
+            if (Status != llvm::MCDisassembler::Success) {
+                PrintRGB("\t<invalid>\n", 200, 100, 100);
+                Address += Size;
+                continue;
+            }
+
+            std::string Text;
+            llvm::raw_string_ostream TextStream(Text);
+            Printer->printInst(&Inst, Address, "", STI, TextStream);
+            TextStream.flush();
+
+            uint64_t BranchTarget = 0;
+            bool IsBackEdge = Analysis && Analysis->isBranch(Inst) &&
+                              Analysis->evaluateBranch(Inst, Address, Size, BranchTarget) &&
+                              BranchTarget >= Function.Start && BranchTarget <= Address;
+
+            if (IsBackEdge) {
+                PrintRGB(Text, 255, 150, 50);
+                PrintRGB("  ; loop back-edge\n", 100, 100, 100);
+                Loops.push_back({BranchTarget, Address + Size});
+            } else {
+                PrintRGB(Text + "\n", 200, 200, 200);
+            }
+
+            Instructions.push_back({Address, Inst});
+            Address += Size;
+        }
+
+        if (Loops.empty()) continue;
+
+        PrintRGB("\n  Throughput (" + Function.Name + ")\n", 0, 255, 255);
+        for (const auto& [LoopStart, LoopEnd] : Loops) {
+            std::vector<std::pair<uint64_t, llvm::MCInst>> Body;
+            for (const auto& Entry : Instructions) {
+                if (Entry.first >= LoopStart && Entry.first < LoopEnd) {
+                    Body.push_back(Entry);
+                }
+            }
+            PrintLoopThroughput(Body, LoopStart, LoopEnd);
+        }
+    }
+    std::cout << "\n";
 }
 
 NativeAssemblyAnalyzer::~NativeAssemblyAnalyzer() {
     delete TargetMachine;
-}
\ No newline at end of file
+}
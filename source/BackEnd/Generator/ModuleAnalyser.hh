@@ -1,3 +1,5 @@
+#pragma once
+
 #include "LLVMHeader.hh"
 
 class ModuleAnalyzer {
@@ -21,12 +23,54 @@ class NativeAssemblyAnalyzer {
 private:
     llvm::Module* Module;
     llvm::TargetMachine* TargetMachine;
-    bool HasLLC;
+    std::string TargetTriple;
+    std::string CPU;
+    std::string Features;
+
+    void PrintLoopThroughput(const std::vector<std::pair<uint64_t, llvm::MCInst>>& Body, uint64_t Start, uint64_t End);
     
 public:
-    NativeAssemblyAnalyzer(llvm::Module* M);
+    NativeAssemblyAnalyzer(llvm::Module* M, const std::string& Triple = "", const std::string& CPUName = "", const std::string& FeatureString = "");
     void PrintNativeAssembly();
     ~NativeAssemblyAnalyzer();
 };
 
+struct OptimisationRemark {
+    std::string Kind;
+    std::string Pass;
+    std::string Name;
+    std::string Function;
+    std::string File;
+    unsigned Line = 0;
+    unsigned Column = 0;
+    std::string Message;
+};
+
+class RemarkCollector : public llvm::DiagnosticHandler {
+private:
+    std::vector<OptimisationRemark>& Remarks;
+    llvm::Regex PassFilter;
+    bool Collecting;
+    fs::path InputFile;
+
+public:
+    // an empty filter records only optimisation failures, which are never filtered
+    RemarkCollector(std::vector<OptimisationRemark>& Out, const std::string& Filter, const fs::path& Input);
+    bool handleDiagnostics(const llvm::DiagnosticInfo& DI) override;
+    bool isAnalysisRemarkEnabled(llvm::StringRef PassName) const override;
+    bool isMissedOptRemarkEnabled(llvm::StringRef PassName) const override;
+    bool isPassedOptRemarkEnabled(llvm::StringRef PassName) const override;
+    bool isAnyRemarkEnabled() const override;
+};
+
+class RemarkAnalyzer {
+private:
+    const std::vector<OptimisationRemark>& Remarks;
+
+public:
+    RemarkAnalyzer(const std::vector<OptimisationRemark>& R);
+    void PrintRemarkReport();
+    bool WriteRemarkFile(const fs::path& Path);
+};
+
 void AnalyzeGeneratedCode(llvm::Module* Module);
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "PlatformBinary.hh"
 #include <cstdlib>
+#include <algorithm>
 
 #include "../../Miscellaneous/conf/TargetMap.hh"
 
-void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Triple, bool RunAfterCompile, int OptLevel, fs::path Output) {
+void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Triple, bool RunAfterCompile, int OptLevel, fs::path Output, const std::string& LinkFlags,
+                          const std::vector<std::string>& LinkInputs, bool ThinLTO, bool FastCompile) {
     if (target_map.find(Triple) != target_map.end()) {
         Triple = target_map[Triple];
     }
@@ -64,7 +66,13 @@ void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Trip
             Write("Code Generation", "Error opening .bc file: " + EC.message(), 2, true, true, "");
             return;
         }
-        llvm::WriteBitcodeToFile(*Module, BCStream);
+        if (ThinLTO) {
+            llvm::ProfileSummaryInfo PSI(*Module);
+            llvm::ModuleSummaryIndex Index = llvm::buildModuleSummaryIndex(*Module, nullptr, &PSI);
+            llvm::WriteBitcodeToFile(*Module, BCStream, false, &Index, true);
+        } else {
+            llvm::WriteBitcodeToFile(*Module, BCStream);
+        }
         BCStream.flush();
         Write("Code Generation", "Generated bitcode", 3, true, true, "");
         return;
@@ -307,7 +315,22 @@ void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Trip
         }
     }
     
-    ClangCommand = "clang -w " + TargetFlag + "-o \"" + FinalOutput.string() + "\" \"" + TempLLFile.string() + "\"" + ExtraFlags;
+    // the module is already optimised; only pick the matching codegen level
+    static const char* CodeGenLevels[] = {"-O0", "-O1", "-O2", "-O3", "-Os", "-Oz"};
+    std::string CodeGenFlag = std::string(CodeGenLevels[std::clamp(OptLevel, 0, 5)]) + " -Xclang -disable-llvm-passes ";
+    if (FastCompile) {
+        // -Og: the quickest instruction selector the target has, with the DAG as fallback
+        bool AArch64 = Triple.rfind("aarch64", 0) == 0 || Triple.rfind("arm64", 0) == 0;
+        CodeGenFlag = std::string("-O0 -Xclang -disable-llvm-passes ") + (AArch64 ? "-mllvm -global-isel -mllvm -global-isel-abort=0 " : "-mllvm -fast-isel ");
+    }
+    std::string DriverFlags = LinkFlags.empty() ? "" : LinkFlags + " ";
+
+    std::string ExtraInputs = "";
+    for (const auto& Input : LinkInputs) {
+        ExtraInputs += " \"" + Input + "\"";
+    }
+
+    ClangCommand = "clang -w " + CodeGenFlag + DriverFlags + TargetFlag + "-o \"" + FinalOutput.string() + "\" \"" + TempLLFile.string() + "\"" + ExtraInputs + ExtraFlags;
     
     int Result = std::system(ClangCommand.c_str());
     
@@ -316,7 +339,7 @@ void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Trip
         Write("Code Generation", "Target toolchain not installed or not available on this platform", 2, true, true, "");
         
         fs::path FallbackObj = OutputDir / (OutputName + ".o");
-        std::string FallbackCommand = "clang -c -w " + TargetFlag + "-o \"" + FallbackObj.string() + "\" \"" + TempLLFile.string() + "\"";
+        std::string FallbackCommand = "clang -c -w " + CodeGenFlag + TargetFlag + "-o \"" + FallbackObj.string() + "\" \"" + TempLLFile.string() + "\"";
         int FallbackResult = std::system(FallbackCommand.c_str());
         
         if (FallbackResult == 0) {
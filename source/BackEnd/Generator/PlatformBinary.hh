@@ -32,4 +32,5 @@ inline void runExecutable(const fs::path& OutputDir, const std::string& OutputNa
 #endif
 }
 
-void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Triple, bool RunAfterCompile, int OptLevel, fs::path Output);
\ No newline at end of file
+void CreatePlatformBinary(std::unique_ptr<llvm::Module> Module, std::string Triple, bool RunAfterCompile, int OptLevel, fs::path Output, const std::string& LinkFlags = "",
+                          const std::vector<std::string>& LinkInputs = {}, bool ThinLTO = false, bool FastCompile = false);
\ No newline at end of file
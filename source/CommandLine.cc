@@ -1,6 +1,7 @@
 #include "Miscellaneous/conf/FileAssociations.hh"
 #include "Miscellaneous/conf/TargetMap.hh"
 #include "CommandLine.hh"
+#include "Tune.hh"
 
 std::unique_ptr<CLIObject> CommandLineHandler(int argc, char* argv[]) {
     auto split = [](const std::string& s, char delim) -> std::vector<std::string> {
@@ -10,8 +11,17 @@ std::unique_ptr<CLIObject> CommandLineHandler(int argc, char* argv[]) {
         return tokens;
     };
 
+    auto count = [](const std::string& opt, const std::string& value, int high = 999999) -> int {
+        if (value.empty() || value.size() > 6 || !std::all_of(value.begin(), value.end(), ::isdigit) || std::stoi(value) > high) {
+            Write("CLI", "Expected a number between 0 and " + std::to_string(high) + " for '" + opt + "', got '" + value + "'", 2, true);
+        }
+        return std::stoi(value);
+    };
+
     auto In = std::make_unique<CLIObject>();
     fs::path cwd = fs::current_path();
+    // options the user gave; a .vxtune file only fills in the rest
+    std::set<std::string> Explicit;
 
     if (argc > 1) {
         if (std::string(argv[1]) == "--h" || std::string(argv[1]) == "--help") {
@@ -28,14 +38,34 @@ std::unique_ptr<CLIObject> CommandLineHandler(int argc, char* argv[]) {
 
     if (In->UsingMenu) return In;
 
-    for (int i = 1; i < argc; i++) {
+    int first = 1;
+    if (argc > 1 && std::string(argv[1]) == "tune") {
+        In->Tune = true;
+        first = 2;
+    }
+
+    for (int i = first; i < argc; i++) {
         std::string arg = argv[i];
         bool recognized = false;
+        // everything but the input, output, tuner options and the settings it searches is passed on to the builds `vexar tune` runs
+        bool forward = true;
+        auto setting = [&](const std::string& key) {
+            Explicit.insert(key);
+            forward = false;
+        };
 
         if (arg == "-o" || arg == "--output") {
             if (i + 1 < argc) In->OutputFile = argv[++i];
             recognized = true;
+            forward = false;
         } 
+        else if (In->Tune && (arg == "--runs" || arg.rfind("--runs=", 0) == 0)) {
+            std::string value = arg == "--runs" ? (i + 1 < argc ? argv[++i] : "") : arg.substr(7);
+            In->TuneRuns = std::max(count("--runs", value), 1);
+            recognized = true;
+            forward = false;
+        }
+        else if (arg == "--no-tune-file")                   { In->UseTuneFile = false; recognized = true; forward = false; }
 
         else if (arg == "-f" || arg == "--full-analysis")   { In->DumpBIN = true; In->DumpIR = true; In->DumpASM = true; In->DumpIR; In->DumpVec = true; In->DumpOp = true; In->DumpSym = true; In->DumpMem = true; In->DumpMod = true; In->DumpTokens = true; In->DumpAST = true; In->DumpBC = true; In->DumpVBC = true; In->DumpVIR; recognized = true;}
         else if (arg == "-m" || arg == "--module")          { In->DumpMod = true; recognized = true;}
@@ -54,6 +84,56 @@ std::unique_ptr<CLIObject> CommandLineHandler(int argc, char* argv[]) {
         else if (arg == "-a" || arg == "--print_ast")       { In->DumpAST = true; recognized = true; }
         else if (arg == "-g" || arg == "--debug")           { In->Debug = true; recognized = true; }
         else if (arg == "-v" || arg == "--verbose")         { In->Verbose = true; recognized = true; }
+        else if (arg == "--remarks")                        { In->Remarks = true; recognized = true; }
+        else if (arg.rfind("--remarks-file=", 0) == 0)      { In->RemarksFile = arg.substr(15); recognized = true; }
+        else if (arg.rfind("--remarks-filter=", 0) == 0)    { In->RemarksFilter = arg.substr(17); recognized = true; }
+        else if (arg.rfind("--stats=", 0) == 0)             { In->StatsFile = arg.substr(8); recognized = true; }
+        else if (arg == "--profile-generate")               { In->ProfileGenerate = true; recognized = true; }
+        else if (arg.rfind("--profile-generate=", 0) == 0)  { In->ProfileGenerate = true; In->ProfileGenerateFile = arg.substr(19); recognized = true; }
+        else if (arg.rfind("--profile-use=", 0) == 0)       { In->ProfileUseFile = arg.substr(14); recognized = true; }
+        else if (arg == "-flto=thin" || arg == "--thinlto")  { In->ThinLTO = true; recognized = true; }
+        else if (arg.rfind("-fveclib=", 0) == 0) {
+            static const std::set<std::string> VectorLibraries = {"auto", "none", "libmvec", "svml", "sleef", "armpl", "accelerate", "darwin_libsystem_m", "amdlibm"};
+            In->VectorLibrary = arg.substr(9);
+            if (!VectorLibraries.count(In->VectorLibrary)) {
+                Write("CLI", "Unrecognized vector library '" + In->VectorLibrary + "'", 2, true);
+            }
+            recognized = true;
+        }
+        else if (arg == "--wrapping" || arg == "-fwrapv")     { In->Wrapping = true; recognized = true; }
+        else if (arg == "-fno-strict-aliasing")             { In->StrictAliasing = false; recognized = true; }
+        else if (arg == "-floop-tiling")                    { In->LoopTiling = true; recognized = true; }
+        else if (arg == "-ffast-math")                      { In->FastMath = true; setting("fast-math"); recognized = true; }
+        else if (arg == "-fno-fast-math")                   { In->FastMath = false; setting("fast-math"); recognized = true; }
+        else if (arg == "-funroll-loops")                   { In->Unroll = true; setting("unroll"); recognized = true; }
+        else if (arg == "-fno-unroll-loops")                { In->Unroll = false; setting("unroll"); recognized = true; }
+        else if (arg == "-fvectorize")                      { In->Vectorize = true; setting("vectorize"); recognized = true; }
+        else if (arg == "-fno-vectorize")                   { In->Vectorize = false; setting("vectorize"); recognized = true; }
+        else if (arg == "-fslp-vectorize")                  { In->SLPVectorize = true; setting("slp-vectorize"); recognized = true; }
+        else if (arg == "-fno-slp-vectorize")               { In->SLPVectorize = false; setting("slp-vectorize"); recognized = true; }
+        else if (arg.rfind("-finline-threshold=", 0) == 0) {
+            In->InlineThreshold = count("-finline-threshold", arg.substr(19), 100000);
+            setting("inline-threshold");
+            recognized = true;
+        }
+        else if (arg.rfind("-finline-rounds=", 0) == 0) {
+            In->InlineRounds = count("-finline-rounds", arg.substr(16), 16);
+            setting("inline-rounds");
+            recognized = true;
+        }
+        else if (arg.rfind("-ffp-contract=", 0) == 0) {
+            In->FPContract = arg.substr(14);
+            if (In->FPContract != "fast" && In->FPContract != "on" && In->FPContract != "off") {
+                Write("CLI", "Unrecognized -ffp-contract mode '" + In->FPContract + "' (expected fast, on or off)", 2, true);
+            }
+            recognized = true;
+        }
+        else if (arg.rfind("-march=", 0) == 0)              { In->TargetCPU = arg.substr(7); recognized = true; }
+        else if (arg.rfind("-mcpu=", 0) == 0)               { In->TargetCPU = arg.substr(6); recognized = true; }
+        else if (arg.rfind("-mattr=", 0) == 0) {
+            In->TargetFeatures += (In->TargetFeatures.empty() ? "" : ",") + arg.substr(7);
+            recognized = true;
+        }
 
         else if (arg == "-r" || arg == "--run")             { In->RunAfterCompile = true; recognized = true; }
         else if (arg == "-w" || arg == "--no-warnings")     { In->EmitWarnings = true; recognized = true; }
@@ -72,29 +152,52 @@ std::unique_ptr<CLIObject> CommandLineHandler(int argc, char* argv[]) {
                 Write("CLI", "Unrecognized target '" + target + "'", 2, true);
             }
         } 
+        else if (arg == "-Og" || arg == "-O1-fast") {
+            In->OptimizationLevel = 1;
+            In->FastCompile = true;
+            setting("opt");
+            recognized = true;
+        }
         else if (arg.rfind("-O", 0) == 0) {
             std::string level = arg.substr(2);
             In->OptimizationLevel = (!level.empty() && isdigit(level[0])) ? std::clamp(level[0] - '0', 0, 5) : 0;
+            In->FastCompile = false;
+            setting("opt");
             recognized = true;
         } else {
             fs::path possibleFile = cwd / arg;
-            if (fs::exists(possibleFile)) { In->InputFile = possibleFile; recognized = true; }
+            std::string ext = possibleFile.extension().string();
+            if (fs::exists(possibleFile) && (ext == ".bc" || ext == ".o" || ext == ".obj" || ext == ".a" || ext == ".lib")) {
+                In->LinkInputs.push_back(possibleFile);
+                recognized = true;
+            }
+            else if (fs::exists(possibleFile)) { In->InputFile = possibleFile; recognized = true; forward = false; }
             else {
                 for (auto& Tag : VexarAssociations) {
                     fs::path p = cwd / (arg + "." + Tag);
-                    if (fs::exists(p)) { In->InputFile = p; recognized = true; break; }
+                    if (fs::exists(p)) { In->InputFile = p; recognized = true; forward = false; break; }
                 }
             }
         }
 
         if (!recognized) Write("CLI", "Unrecognized command-line option '" + arg + "'", 2, true);
+        if (In->Tune && forward) In->TuneArgs.push_back(arg);
     }
 
+    if (In->ProfileGenerate && !In->ProfileUseFile.empty()) Write("CLI", "--profile-generate and --profile-use cannot be combined", 2, true);
+    if (!In->ProfileUseFile.empty() && !fs::exists(In->ProfileUseFile)) Write("CLI", "Profile file does not exist: " + In->ProfileUseFile, 2, true);
+
     if (In->InputFile.empty()) Write("CLI", "No input file specified", 2, true);
     if (!fs::exists(In->InputFile)) Write("CLI", "Input file does not exist: " + In->InputFile.string(), 2, true);
 
     if (In->OutputFile.empty()) In->OutputFile = In->InputFile.parent_path() / (In->InputFile.stem().string() + ".exe");
     else { fs::path p(In->OutputFile); In->OutputFile = p.is_absolute() ? p : cwd / p; }
 
+    if (In->Tune) {
+        if (In->FastCompile) Write("CLI", "-Og trades run time for compile time; vexar tune cannot search under it", 2, true);
+        In->TuneFixed = Explicit;
+    }
+    if (!In->Tune && In->UseTuneFile) ApplyTuneFile(In.get(), Explicit);
+
     return In;
 }
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
 #include <filesystem>
 #include <unordered_map>
@@ -25,9 +26,31 @@ public:
     fs::path InputFile;
     fs::path OutputFile;
     int OptimizationLevel = 0;
+    bool FastCompile = false;
+    int InlineThreshold = -1;
+    int InlineRounds = -1;
+    bool Unroll = true;
+    bool Vectorize = true;
+    bool SLPVectorize = true;
     bool RunAfterCompile = false;
     bool EmitWarnings = false;
     std::string CompilerTarget = "";
+    std::string TargetCPU = "";
+    std::string TargetFeatures = "";
+    std::string RemarksFile = "";
+    std::string RemarksFilter = "";
+    std::string StatsFile = "";
+    bool ProfileGenerate = false;
+    std::string ProfileGenerateFile = "";
+    std::string ProfileUseFile = "";
+    bool ThinLTO = false;
+    bool FastMath = false;
+    bool Wrapping = false;
+    bool StrictAliasing = true;
+    bool LoopTiling = false;
+    std::string FPContract = "";
+    std::string VectorLibrary = "auto";
+    std::vector<fs::path> LinkInputs;
 // debug
     bool Debug = false;
     bool Verbose = false;
@@ -45,6 +68,14 @@ public:
     bool DumpVIR = false;
     bool DumpBC = false;
     bool DumpVBC = false;
+    bool Remarks = false;
+// tune
+    bool Tune = false;
+    int TuneRuns = 5;
+    bool UseTuneFile = true;
+    std::vector<std::string> TuneArgs;
+    // searched settings given to `vexar tune`; held at the user's value instead of searched
+    std::set<std::string> TuneFixed;
 // menu
     bool UsingMenu = false;
     bool HelpMenu = false;
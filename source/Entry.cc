@@ -5,11 +5,13 @@
 #include "FrontEnd/Tokenizer.hh"
 
 #include "MiddleEnd/ProgramParser.hh"
+#include "MiddleEnd/LoopTransform.hh"
 
 #include "BackEnd/Generator/ModuleAnalyser.hh"
 #include "BackEnd/Generator/Generator.hh"
 
 #include "CommandLine.hh"
+#include "Tune.hh"
 #include "Token.hh"
 
 #include <iomanip>
@@ -22,6 +24,7 @@
 #include <sstream>
 #include <ctime>
 #include <chrono>
+#include <fstream>
 
 #include "Menu.hh"
 
@@ -49,8 +52,30 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (Instructions->Tune) {
+        return RunTuner(Instructions.get(), argv[0]);
+    }
+
+    std::map<std::string, double> PhaseTimes;
+    auto PhaseStart = std::chrono::high_resolution_clock::now();
+    auto EndPhase = [&](const std::string& Phase) {
+        auto Now = std::chrono::high_resolution_clock::now();
+        PhaseTimes[Phase] += std::chrono::duration<double>(Now - PhaseStart).count();
+        PhaseStart = Now;
+    };
+
+    auto CountInstructions = [](llvm::Module* M) {
+        size_t Count = 0;
+        for (auto& F : *M) {
+            Count += F.getInstructionCount();
+        }
+        return Count;
+    };
+
     Instructions->FileContents = SerializeFile(Instructions->InputFile);
+    EndPhase("serialize");
     Instructions->ProgramTokens = Tokenize(Instructions->FileContents);
+    EndPhase("tokenize");
 
     if (Instructions->Verbose) {   
         Write("CLI", "Serialization Complete", 3, true, true);
@@ -87,7 +112,12 @@ int main(int argc, char* argv[]) {
         Write("CLI", "Generating Program", 3, true, true);
     }
 
+    PhaseStart = std::chrono::high_resolution_clock::now();
     Instructions->ProgramAST = ParseProgram(Instructions->ProgramTokens);
+    EndPhase("parse");
+    LoopTransform::Run(Instructions->ProgramAST.get(), Instructions->LoopTiling, Instructions->Verbose);
+    EndPhase("loop-transform");
+    size_t ASTNodeCount = ASTNode::Allocated;
 
     if (Instructions->DumpAST) {
         Write("Parser", Instructions->ProgramAST->get(), 0, true);
@@ -98,26 +128,51 @@ int main(int argc, char* argv[]) {
     pkg.InputFile = Instructions->InputFile;
     pkg.OutputFile = Instructions->OutputFile;
     pkg.Optimisation = Instructions->OptimizationLevel;
+    pkg.FastCompile = Instructions->FastCompile;
+    pkg.InlineThreshold = Instructions->InlineThreshold;
+    pkg.InlineRounds = Instructions->InlineRounds;
+    pkg.Unroll = Instructions->Unroll;
+    pkg.Vectorize = Instructions->Vectorize;
+    pkg.SLPVectorize = Instructions->SLPVectorize;
     pkg.Verbose = Instructions->Verbose;
     pkg.Debug = Instructions->Debug;
     pkg.RunAfterCompile = Instructions->RunAfterCompile;
     pkg.CompilerTarget = Instructions->CompilerTarget;
+    pkg.TargetCPU = Instructions->TargetCPU;
+    pkg.TargetFeatures = Instructions->TargetFeatures;
+    pkg.ProfileGenerate = Instructions->ProfileGenerate;
+    pkg.ProfileGenerateFile = Instructions->ProfileGenerateFile;
+    pkg.ProfileUseFile = Instructions->ProfileUseFile;
+    pkg.ThinLTO = Instructions->ThinLTO;
+    pkg.FastMath = Instructions->FastMath;
+    pkg.Wrapping = Instructions->Wrapping;
+    pkg.StrictAliasing = Instructions->StrictAliasing;
+    pkg.FPContract = Instructions->FPContract;
+    pkg.VectorLibrary = Instructions->VectorLibrary;
+    pkg.LinkInputs = Instructions->LinkInputs;
+    pkg.Remarks = Instructions->Remarks;
+    pkg.RemarksFile = Instructions->RemarksFile;
+    pkg.RemarksFilter = Instructions->RemarksFilter;
 
     if (Instructions->Verbose) {   
         std::ostringstream ss;
         ss << "Compiling with flags:\n"
         << "  Input File: "    << Instructions->InputFile << "\n"
         << "  Output File: "   << Instructions->OutputFile << "\n"
-        << "  Optimization: O" << Instructions->OptimizationLevel << "\n"
+        << "  Optimization: " << (Instructions->FastCompile ? "Og" : "O" + std::to_string(Instructions->OptimizationLevel)) << "\n"
         << "  Verbose: "       << (Instructions->Verbose ? "true" : "false") << "\n"
         << "  Debug: "         << (Instructions->Debug ? "true" : "false") << "\n";
         
         Write("CLI", ss.str(), 1, true, true);
     }
 
+    PhaseStart = std::chrono::high_resolution_clock::now();
     Generator Gen(pkg);
     llvm::Module* Mode = Gen.GetModulePtr();
     Gen.BuildModule();
+    EndPhase("codegen");
+    size_t IRInstructionsBefore = CountInstructions(Mode);
+    size_t IRInstructionsAfter = IRInstructionsBefore;
 
     auto V_C_END = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = V_C_END - V_C_START;
@@ -160,11 +215,6 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    if (Instructions->DumpASM) {
-        NativeAssemblyAnalyzer AsmAnalyzer(Mode);
-        AsmAnalyzer.PrintNativeAssembly();
-    }
-
     if (Instructions->DumpIR) {
         Gen.PrintModule();
     }
@@ -177,8 +227,49 @@ int main(int argc, char* argv[]) {
             Write("CLI", "Module validation failed. Errors were found.", 2, true, true);
         }
     } else {
+        PhaseStart = std::chrono::high_resolution_clock::now();
         Gen.OptimiseModule();
+        EndPhase("optimise");
+        IRInstructionsAfter = CountInstructions(Mode);
+    }
+
+    if (Instructions->DumpASM) {
+        llvm::TargetMachine* TM = Gen.GetTargetMachine();
+        NativeAssemblyAnalyzer AsmAnalyzer(Mode, Mode->getTargetTriple().str(),
+                                           TM ? TM->getTargetCPU().str() : "",
+                                           TM ? TM->getTargetFeatureString().str() : "");
+        AsmAnalyzer.PrintNativeAssembly();
+    }
+
+    if (!Instructions->Check) {
+        PhaseStart = std::chrono::high_resolution_clock::now();
         Gen.CompileTriple();
+        EndPhase("emit");
+    }
+
+    if (!Instructions->StatsFile.empty()) {
+        std::ofstream Stats(Instructions->StatsFile);
+        if (!Stats.is_open()) {
+            Write("CLI", "Failed to write stats file: " + Instructions->StatsFile, 2, true, true);
+        } else {
+            std::chrono::duration<double> Total = std::chrono::high_resolution_clock::now() - V_C_START;
+            Stats << "{\n"
+                  << "  \"optimisation\": " << Instructions->OptimizationLevel << ",\n"
+                  << "  \"fast_compile\": " << (Instructions->FastCompile ? "true" : "false") << ",\n"
+                  << "  \"tokens\": " << Instructions->ProgramTokens.size() << ",\n"
+                  << "  \"ast_nodes\": " << ASTNodeCount << ",\n"
+                  << "  \"ir_instructions\": " << IRInstructionsBefore << ",\n"
+                  << "  \"ir_instructions_optimised\": " << IRInstructionsAfter << ",\n"
+                  << "  \"phases\": {";
+            bool First = true;
+            for (const auto& [Phase, Seconds] : PhaseTimes) {
+                Stats << (First ? "" : ",") << "\n    \"" << Phase << "\": " << std::fixed << std::setprecision(6) << Seconds;
+                First = false;
+            }
+            Stats << "\n  },\n"
+                  << "  \"total\": " << std::fixed << std::setprecision(6) << Total.count() << "\n"
+                  << "}\n";
+        }
     }
 
     if (Instructions->Verbose) {
@@ -4,6 +4,8 @@
 #include <filesystem>
 #include <algorithm>
 
+std::map<unsigned int, std::pair<std::string, unsigned int>> SourceLineOrigins;
+
 std::vector<Token> Tokenize(const std::map<unsigned int, std::string>& FileContents) {
     std::set<std::string> importedFiles;
     auto processedContent = ProcessImports(FileContents, importedFiles);
@@ -284,13 +286,16 @@ std::map<unsigned int, std::string> ProcessImports(const std::map<unsigned int,
                 
                 std::istringstream contentStream(fileContent);
                 std::string contentLine;
+                unsigned int importedLine = 1;
                 while (std::getline(contentStream, contentLine)) {
                     result[currentLine] = contentLine;
+                    SourceLineOrigins[currentLine] = {fileToImport, importedLine++};
                     currentLine++;
                 }
             }
         } else {
             result[currentLine] = line;
+            SourceLineOrigins[currentLine] = {"", lineNumber};
             currentLine++;
         }
     }
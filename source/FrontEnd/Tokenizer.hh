@@ -11,6 +11,8 @@
 #include <filesystem>
 #include <set>
 
+extern std::map<unsigned int, std::pair<std::string, unsigned int>> SourceLineOrigins;
+
 std::string FindFileWithExtension(const std::string& basePath);
 std::vector<std::string> FindAllFilesInDirectory(const std::string& dirPath);
 std::map<unsigned int, std::string> ProcessImports(const std::map<unsigned int, std::string>& FileContents, std::set<std::string>& importedFiles);
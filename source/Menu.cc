@@ -7,12 +7,18 @@ void PrintVesion() {
 
 void PrintHelpMenu() {
     std::cout << "Usage:\n";
-    std::cout << "  vexar [options] <file>\n\n";
+    std::cout << "  vexar [options] <file>\n";
+    std::cout << "  vexar tune <file> [--runs N] [options]\n\n";
 
     std::cout << "Commands:\n";
     std::cout << "  --h, --help          Show this help message and exit\n";
     std::cout << "  --v --version        Show version information\n";
-    std::cout << "  --t, --targets       Show available compilation targets\n\n";
+    std::cout << "  --t, --targets       Show available compilation targets\n";
+    std::cout << "  tune                 Time builds of <file> under different pipeline settings (N runs each, default 5)\n";
+    std::cout << "                       and write the fastest to <file>.vxtune, which later builds pick up;\n";
+    std::cout << "                       pipeline options given here (-O, -finline-*, -f[no-]vectorize, ...) stay fixed;\n";
+    std::cout << "                       the program is started directly, so timings exclude shell startup, and every\n";
+    std::cout << "                       run must exit with 0, or that configuration is rejected\n\n";
 
     std::cout << "Compiler Options:\n";
     std::cout << "  -I, --include <dir>     Add directory to import/include path\n";
@@ -20,7 +26,30 @@ void PrintHelpMenu() {
     std::cout << "  -t, --target=<target>   Specify the compilation target (see --targets)\n";
     std::cout << "  -w, --no-warnings       Suppress warning messages\n";
     std::cout << "  -r, --run               Compile and run the program directly\n";
-    std::cout << "  -O[level]               Set optimization level (0-5)\n\n";
+    std::cout << "  -march=native           Optimise for the host CPU and all of its features\n";
+    std::cout << "  -mcpu=<cpu>             Optimise for a specific CPU (e.g. skylake-avx512, x86-64-v3)\n";
+    std::cout << "  -mattr=<+feat,-feat>    Enable or disable target features (e.g. +avx2,+avx512f)\n";
+    std::cout << "  --profile-generate[=<file>]  Instrument the binary; runs write <output>-%m.profraw\n";
+    std::cout << "  --profile-use=<file>    Optimise with a profile merged by 'llvm-profdata merge'\n";
+    std::cout << "  -flto=thin, --thinlto   Emit ThinLTO summaries and optimise across modules at link time\n";
+    std::cout << "  --wrapping, -fwrapv     Make signed integer overflow wrap instead of being undefined (disables nsw)\n";
+    std::cout << "  -fno-strict-aliasing    Do not emit type-based alias metadata on loads and stores\n";
+    std::cout << "  -floop-tiling           Fuse, interchange and tile affine loop nests over arrays (@tile works without it)\n";
+    std::cout << "  -ffast-math             Allow reassociation, contraction and no-NaN/Inf assumptions on all float math\n";
+    std::cout << "  -ffp-contract=<mode>    Fuse multiply-add: fast (across statements), on (within an expression, default) or off\n";
+    std::cout << "  -fveclib=<lib>          Vector math library for vectorized sin/exp/log/...: auto (default), none,\n";
+    std::cout << "                          libmvec, svml, sleef, armpl, accelerate, darwin_libsystem_m, amdlibm\n";
+    std::cout << "                          (auto picks svml on MSVC only when svml_dispmd.lib is on LIB; otherwise\n";
+    std::cout << "                          transcendentals are not vectorized there)\n";
+    std::cout << "  <file>.bc|.o|.a         Extra inputs to link (e.g. Vexar modules built with --target=bitcode -flto=thin)\n";
+    std::cout << "  -O[level]               Set optimization level (0-5)\n";
+    std::cout << "  -Og, -O1-fast           Fast-compile tier: SROA, early CSE, instcombine and simplifycfg, FastISel backend\n";
+    std::cout << "  -finline-threshold=<n>  Inliner cost threshold (default: the level's own)\n";
+    std::cout << "  -finline-rounds=<n>     Extra inliner rounds after the -O3 pipeline (default 2)\n";
+    std::cout << "  -fno-unroll-loops       Disable loop unrolling and interleaving\n";
+    std::cout << "  -fno-vectorize          Disable the loop vectorizer (-fno-slp-vectorize for the SLP vectorizer)\n";
+    std::cout << "  -fno-fast-math          Undo -ffast-math, e.g. one picked up from a .vxtune file\n";
+    std::cout << "  --no-tune-file          Ignore <file>.vxtune written by 'vexar tune'\n\n";
 
     std::cout << "Analysis Options:\n";
     std::cout << "  -f, --full-analysis       Perform full module analysis (all options)\n";
@@ -30,12 +59,16 @@ void PrintHelpMenu() {
     std::cout << "  -s, --symbols             Analyze module symbols\n";
     std::cout << "  -e, --memory              Analyze memory usage\n";
     std::cout << "  -m, --module              Analyze module structure\n";
-    std::cout << "  -d, --dump                Dump assembler information\n";
+    std::cout << "  -d, --dump                Dump native assembly with loop throughput estimates\n";
     std::cout << "  -bc, --dump-bc            Dump bitcode\n";
     std::cout << "  -vbc, --dump-verbose-bc   Dump the verbose binary; bitcode\n";
     std::cout << "  -ir, --dump-ir            Dump the generated LLVM IR\n";
     std::cout << "  -vir, --dump-verbose-ir   Dump the disassembled LLVM IR\n";
     std::cout << "  -c, --check               Check syntax only (no codegen)\n";
+    std::cout << "  --remarks                 Print LLVM optimisation remarks mapped to source\n";
+    std::cout << "  --remarks-file=<file>     Write remarks as YAML (or JSON for .json files)\n";
+    std::cout << "  --remarks-filter=<regex>  Passes to report (default: loop-vectorize|loop-unroll|inline|licm|gvn)\n";
+    std::cout << "  --stats=<file>            Write phase timings and token/AST/IR counts as JSON\n";
     std::cout << "  -g, --debug               Enable debug mode\n";
     std::cout << "  -v, --verbose             Enable verbose output\n";
     std::cout << "  -t, --print-tokens        Print token stream\n";
@@ -39,11 +39,15 @@ struct NodeType {
     static constexpr int For = 29;
     static constexpr int ForEach = 30;
     static constexpr int InlineCodeBlock = 31;
+    static constexpr int Ternary = 32;
+    static constexpr int Match = 33;
 };
 
 struct ASTNode {
     int type;
     Token token;
+    static inline std::size_t Allocated = 0;
+    ASTNode() { ++Allocated; }
     virtual ~ASTNode() = default;
     virtual std::string get(const std::string& prefix = "", bool isLast = true) const = 0;
 protected:
@@ -122,6 +126,22 @@ struct BinaryOpNode : ASTNode {
     }
 };
 
+struct TernaryNode : ASTNode {
+    std::unique_ptr<ASTNode> condition;
+    std::unique_ptr<ASTNode> thenExpr;
+    std::unique_ptr<ASTNode> elseExpr;
+
+    std::string get(const std::string& prefix = "", bool isLast = true) const override {
+        std::ostringstream oss;
+        oss << branch(prefix, isLast) << "[Ternary]";
+        std::string childPrefix = nextPrefix(prefix, isLast);
+        if (condition) oss << "\n" << condition->get(childPrefix, false);
+        if (thenExpr) oss << "\n" << thenExpr->get(childPrefix, false);
+        if (elseExpr) oss << "\n" << elseExpr->get(childPrefix, true);
+        return oss.str();
+    }
+};
+
 struct UnaryOpNode : ASTNode {
     std::unique_ptr<ASTNode> operand;
     std::string op;
@@ -181,16 +201,27 @@ struct TypeNode : ASTNode {
     }
 };
 
+// `@name` or `@name(args)` annotation on a function, block or variable
+struct AttributeSpec {
+    std::string name;
+    std::vector<std::string> args;
+    Token token;
+};
+
 struct VariableNode : ASTNode {
     std::string name;
     TypeNode varType;
     std::unique_ptr<ASTNode> value;
     std::unique_ptr<ASTNode> arrayExpression;
+    std::vector<AttributeSpec> attributes;
 
     VariableNode() : varType("auto") {}
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::string result = branch(prefix, isLast) + "[Variable]: " + name + " : " + varType.name;
+        for (const auto& a : attributes) {
+            result += " @" + a.name;
+        }
 
         if (arrayExpression) {
             bool arrIsLast = !value;
@@ -265,10 +296,14 @@ struct DecrementOpNode : public ASTNode {
 
 struct BlockNode : ASTNode {
     std::vector<std::unique_ptr<ASTNode>> statements;
+    std::vector<AttributeSpec> attributes;
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
         oss << branch(prefix, isLast) << "[Block]: ";
+        for (const auto& a : attributes) {
+            oss << "@" << a.name << " ";
+        }
         for (size_t i = 0; i < statements.size(); ++i) {
             bool last = (i == statements.size() - 1);
             oss << "\n" << statements[i]->get(nextPrefix(prefix, isLast), last);
@@ -279,10 +314,11 @@ struct BlockNode : ASTNode {
 
 struct ConditionNode : ASTNode {
     std::unique_ptr<ASTNode> expression;
+    int likelihood = 0;  // 1 = likely, -1 = unlikely
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
-        oss << branch(prefix, isLast) << "[Condition]: ";
+        oss << branch(prefix, isLast) << "[Condition]: " << (likelihood > 0 ? "[likely]" : likelihood < 0 ? "[unlikely]" : "");
         if (expression)
             oss << "\n" << expression->get(nextPrefix(prefix, isLast), true);
         return oss.str();
@@ -335,22 +371,56 @@ struct IfNode : ASTNode {
 struct WhileNode : ASTNode {
     std::unique_ptr<ConditionNode> condition;
     std::unique_ptr<BlockNode> block;
+    std::vector<AttributeSpec> attributes;
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
         oss << branch(prefix, isLast) << "[While]";
+        for (const auto& a : attributes) {
+            oss << " @" << a.name;
+        }
         if (condition) oss << "\n" << condition->get(nextPrefix(prefix, isLast), false);
         if (block) oss << "\n" << block->get(nextPrefix(prefix, isLast), true);
         return oss.str();
     }
 };
 
+struct MatchNode : ASTNode {
+    struct Arm {
+        std::vector<Token> patterns;  // integer, character or string literals
+        std::unique_ptr<BlockNode> block;
+    };
+
+    std::unique_ptr<ASTNode> subject;
+    std::vector<Arm> arms;
+    std::unique_ptr<BlockNode> defaultBlock;
+
+    std::string get(const std::string& prefix = "", bool isLast = true) const override {
+        std::ostringstream oss;
+        oss << branch(prefix, isLast) << "[Match]";
+        std::string childPrefix = nextPrefix(prefix, isLast);
+        if (subject) oss << "\n" << subject->get(childPrefix, arms.empty() && !defaultBlock);
+        for (size_t i = 0; i < arms.size(); ++i) {
+            bool lastArm = (i == arms.size() - 1) && !defaultBlock;
+            oss << "\n" << branch(childPrefix, lastArm) << "[Arm]:";
+            for (const auto& p : arms[i].patterns) oss << " " << p.value;
+            if (arms[i].block) oss << "\n" << arms[i].block->get(nextPrefix(childPrefix, lastArm), true);
+        }
+        if (defaultBlock) {
+            oss << "\n" << branch(childPrefix, true) << "[Arm]: else";
+            oss << "\n" << defaultBlock->get(nextPrefix(childPrefix, true), true);
+        }
+        return oss.str();
+    }
+};
+
 struct ReturnNode : ASTNode {
     std::unique_ptr<ASTNode> value;
+    bool isBecome = false;  // `become f(...)`: the call must be a guaranteed tail call
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
-        oss << branch(prefix, isLast) << "[Return]";
+        oss << branch(prefix, isLast) << (isBecome ? "[Become]" : "[Return]");
         if (value) {
             oss << "\n" << value->get(nextPrefix(prefix, isLast), true);
         }
@@ -361,14 +431,27 @@ struct ReturnNode : ASTNode {
 struct FunctionNode : ASTNode {
     std::string name;
     std::vector<std::tuple<std::string, std::string, int>> params;
+    std::vector<bool> restrictParams;  // parallel to params
     std::string returnType = "void";
     std::unique_ptr<BlockNode> body;
     bool isInlined = false;
     bool alwaysInline = false;
+    bool isExported = false;
+    std::vector<AttributeSpec> attributes;
     
+    bool hasAttribute(const std::string& attr) const {
+        for (const auto& a : attributes) {
+            if (a.name == attr) return true;
+        }
+        return false;
+    }
+
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
-        oss << branch(prefix, isLast) << "[Function]: " << name << " : " << returnType;
+        oss << branch(prefix, isLast) << "[Function]: " << name << " : " << returnType << (isExported ? " [export]" : "");
+        for (const auto& a : attributes) {
+            oss << " @" << a.name;
+        }
 
         std::string childPrefix = nextPrefix(prefix, isLast);
         bool hasParams = !params.empty();
@@ -382,6 +465,7 @@ struct FunctionNode : ASTNode {
             for (size_t i = 0; i < params.size(); ++i) {
                 bool lastParam = (i == params.size() - 1);
                 oss << "\n" << branch(paramsChildPrefix, lastParam)
+                    << (i < restrictParams.size() && restrictParams[i] ? "restrict " : "")
                     << std::get<0>(params[i]) << " : " << std::get<1>(params[i]);
             }
         }
@@ -531,12 +615,16 @@ struct ForNode : ASTNode {
     std::unique_ptr<ConditionNode> condition;
     std::unique_ptr<ASTNode> increment;
     std::unique_ptr<BlockNode> body;
+    std::vector<AttributeSpec> attributes;
 
     ForNode() { type = NodeType::For; }
 
     std::string get(const std::string& prefix = "", bool isLast = true) const override {
         std::ostringstream oss;
         oss << branch(prefix, isLast) << "[For]";
+        for (const auto& a : attributes) {
+            oss << " @" << a.name;
+        }
         std::string childPrefix = nextPrefix(prefix, isLast);
         
         if (init) {
@@ -0,0 +1,114 @@
+#include "AttributeExpression.hh"
+#include "../Nodes/BlockNode.hh"
+#include "../ParseExpression.hh"
+#include "../../Miscellaneous/LoggerHandler/LoggerFile.hh"
+
+namespace AttributeExpression {
+
+    // @name or @name(arg, key=value, ...) in front of a function declaration, a block, a variable or a loop
+    std::unique_ptr<ASTNode> Parse(Parser& parser) {
+        std::vector<AttributeSpec> attributes;
+
+        while (parser.peek().value == "@" && parser.peek().type == TokenType::Delimiter) {
+            Token at = parser.advance();
+            Token nameTok = parser.peek();
+            if (nameTok.type != TokenType::Identifier && nameTok.type != TokenType::Keyword) {
+                Write("Parser", "Expected attribute name after '@' at line " + std::to_string(at.line) +
+                      ", column " + std::to_string(at.column), 2, true, true, "");
+                return nullptr;
+            }
+            parser.advance();
+
+            AttributeSpec attr;
+            attr.name = nameTok.value;
+            attr.token = nameTok;
+
+            if (parser.peek().value == "(") {
+                parser.advance();
+                while (parser.peek().value != ")" && parser.peek().type != TokenType::EndOfFile) {
+                    std::string arg = parser.advance().value;
+                    if (parser.peek().value == "=") {
+                        parser.advance();
+                        arg += "=" + parser.advance().value;
+                    }
+                    attr.args.push_back(arg);
+                    if (parser.peek().value == ",") {
+                        parser.advance();
+                    } else if (parser.peek().value != ")") {
+                        Write("Parser", "Expected ',' or ')' in arguments of '@" + attr.name + "' at line " +
+                              std::to_string(parser.peek().line) + ", column " + std::to_string(parser.peek().column), 2, true, true, "");
+                        return nullptr;
+                    }
+                }
+                parser.consume(TokenType::Delimiter, ")");
+            }
+
+            attributes.push_back(attr);
+        }
+
+        if (parser.peek().value == "{" && parser.peek().type == TokenType::Delimiter) {
+            auto Block = BlockNodeContainer::ParseBlock(parser);
+            if (Block) {
+                Block->token = attributes.front().token;
+                Block->attributes = attributes;
+            }
+            return Block;
+        }
+
+        if (parser.peek().value == "var" && parser.peek().type == TokenType::Keyword) {
+            auto Node = Main::ParseExpression(parser);
+            if (!Node || Node->type != NodeType::Variable) {
+                Write("Parser", "Expected a variable declaration after attributes at line " + std::to_string(attributes.front().token.line) +
+                      ", column " + std::to_string(attributes.front().token.column), 2, true, true, "");
+                return nullptr;
+            }
+            static_cast<VariableNode*>(Node.get())->attributes = attributes;
+            return Node;
+        }
+
+        if ((parser.peek().value == "for" || parser.peek().value == "while") && parser.peek().type == TokenType::Keyword) {
+            auto Node = Main::ParseExpression(parser);
+            if (!Node) {
+                return nullptr;
+            }
+            if (Node->type == NodeType::For) {
+                static_cast<ForNode*>(Node.get())->attributes = attributes;
+            } else if (Node->type == NodeType::While) {
+                static_cast<WhileNode*>(Node.get())->attributes = attributes;
+            }
+            return Node;
+        }
+
+        // qualifiers between the attributes and 'func' go straight onto the function node, in any order
+        bool exported = false, inlined = false, alwaysInline = false;
+        while (parser.peek().value == "export" || parser.peek().value == "inline" || parser.peek().value == "always_inline") {
+            Token qualifier = parser.advance();
+            if (qualifier.value == "export") exported = true;
+            else if (qualifier.value == "inline") inlined = true;
+            else alwaysInline = true;
+        }
+        if (inlined && alwaysInline) {
+            Write("Parser", "A function cannot be both 'inline' and 'always_inline' at line " + std::to_string(attributes.front().token.line) +
+                  ", column " + std::to_string(attributes.front().token.column), 2, true, true, "");
+            return nullptr;
+        }
+
+        if (parser.peek().value != "func") {
+            const Token& tok = parser.peek();
+            Write("Parser", "Attributes must be followed by a function declaration, a block, a variable or a loop, got '" + tok.value +
+                  "' at line " + std::to_string(tok.line) + ", column " + std::to_string(tok.column), 2, true, true, "");
+            return nullptr;
+        }
+
+        auto Node = FunctionExpression::Parse(parser);
+        if (Node) {
+            auto* Function = static_cast<FunctionNode*>(Node.get());
+            Function->attributes = attributes;
+            Function->isExported = exported;
+            Function->isInlined = inlined;
+            Function->alwaysInline = alwaysInline;
+        }
+        return Node;
+    }
+
+}
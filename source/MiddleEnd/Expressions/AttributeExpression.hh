@@ -0,0 +1,10 @@
+#pragma once
+#include "../AST.hh"
+#include "../../Token.hh"
+#include "../Parser.hh"
+#include <memory>
+#include <string>
+
+namespace AttributeExpression {
+    std::unique_ptr<ASTNode> Parse(Parser& parser);
+}
@@ -6,7 +6,15 @@
 namespace FunctionExpression {
 
     std::unique_ptr<ASTNode> Parse(Parser& parser) {
-        Token inline_q = parser.peek(-1);
+        // 'export', 'inline' and 'always_inline' in front of 'func' were consumed as statements of their own, in either order
+        bool exported = false, inlined = false, alwaysInline = false;
+        for (int back = -1; back >= -2; back--) {
+            const std::string& qualifier = parser.peek(back).value;
+            if (qualifier == "export") exported = true;
+            else if (qualifier == "inline") inlined = true;
+            else if (qualifier == "always_inline") alwaysInline = true;
+            else break;
+        }
 
         parser.advance();
 
@@ -23,18 +31,20 @@ namespace FunctionExpression {
         funcNode->type = NodeType::Function;
         funcNode->name = nameTok.value;
 
-        funcNode->isInlined = false;
-        funcNode->alwaysInline = false;
-
-        if (inline_q.value == "inline") {
-            funcNode->isInlined = true;
-        } else if (inline_q.value == "always_inline") {
-            funcNode->alwaysInline = true;
-        }
+        funcNode->isInlined = inlined && !alwaysInline;
+        funcNode->alwaysInline = alwaysInline;
+        funcNode->isExported = exported;
 
         if (parser.peek().value == "(") {
             parser.advance();
             while (parser.peek().value != ")" && parser.peek().type != TokenType::EndOfFile) {
+                // `restrict` is contextual: only a qualifier when a parameter name follows it
+                bool isRestrict = false;
+                if (parser.peek().value == "restrict" && parser.peekNext().type == TokenType::Identifier) {
+                    isRestrict = true;
+                    parser.advance();
+                }
+
                 Token paramName = parser.peek();
                 if (paramName.type != TokenType::Identifier) {
                     Write("Parser", "Expected parameter name, got '" + paramName.value +
@@ -82,6 +92,7 @@ namespace FunctionExpression {
                 }
 
                 funcNode->params.push_back({paramName.value, typeString, dimensions});
+                funcNode->restrictParams.push_back(isRestrict);
 
                 if (parser.peek().value == ",") {
                     parser.advance();
@@ -0,0 +1,85 @@
+#include "MatchStatementExpression.hh"
+#include "NumberExpression.hh"
+#include "../Nodes/BlockNode.hh"
+#include "../../Miscellaneous/LoggerHandler/LoggerFile.hh"
+
+namespace MatchStatementExpression {
+
+    static std::unique_ptr<BlockNode> ParseArmBlock(Parser& parser, const Token& armTok) {
+        if (parser.peek().value != "=>") {
+            Write("Parser", "Expected '=>' after match pattern at line " + std::to_string(parser.peek().line) +
+                  ", column " + std::to_string(parser.peek().column), 2, true, true, "");
+            return nullptr;
+        }
+        parser.advance();
+
+        auto block = BlockNodeContainer::ParseBlock(parser);
+        if (!block) {
+            Write("Parser", "Missing block for match arm at line " + std::to_string(armTok.line) +
+                  ", column " + std::to_string(armTok.column), 2, true, true, "");
+            return nullptr;
+        }
+        return std::unique_ptr<BlockNode>(static_cast<BlockNode*>(block.release()));
+    }
+
+    // match (x) { 1, 2 => { ... } 'a' => { ... } "add" => { ... } else => { ... } }
+    std::unique_ptr<ASTNode> Parse(Parser& parser) {
+        Token matchTok = parser.advance();
+
+        auto matchNode = std::make_unique<MatchNode>();
+        matchNode->type = NodeType::Match;
+        matchNode->token = matchTok;
+
+        matchNode->subject = NumberExpression::ParseExpression(parser, {"{"});
+        if (!matchNode->subject) {
+            Write("Parser", "Expected expression after 'match' at line " + std::to_string(matchTok.line) +
+                  ", column " + std::to_string(matchTok.column), 2, true, true, "");
+            return nullptr;
+        }
+
+        parser.consume(TokenType::Delimiter, "{");
+
+        while (parser.peek().value != "}" && parser.peek().type != TokenType::EndOfFile) {
+            Token armTok = parser.peek();
+
+            if (armTok.value == "else") {
+                if (matchNode->defaultBlock) {
+                    Write("Parser", "Duplicate 'else' arm in match at line " + std::to_string(armTok.line) +
+                          ", column " + std::to_string(armTok.column), 2, true, true, "");
+                    return nullptr;
+                }
+                parser.advance();
+                matchNode->defaultBlock = ParseArmBlock(parser, armTok);
+                if (!matchNode->defaultBlock) return nullptr;
+                continue;
+            }
+
+            MatchNode::Arm arm;
+            while (true) {
+                Token patTok = parser.advance();
+                if (patTok.value == "-" && parser.peek().type == TokenType::Number) {
+                    Token numTok = parser.advance();
+                    numTok.value = "-" + numTok.value;
+                    patTok = numTok;
+                }
+                if (patTok.type != TokenType::Number && patTok.type != TokenType::Character && patTok.type != TokenType::String) {
+                    Write("Parser", "Match patterns must be integer, character or string literals, got '" + patTok.value +
+                          "' at line " + std::to_string(patTok.line) + ", column " + std::to_string(patTok.column), 2, true, true, "");
+                    return nullptr;
+                }
+                arm.patterns.push_back(patTok);
+
+                if (parser.peek().value != ",") break;
+                parser.advance();
+            }
+
+            arm.block = ParseArmBlock(parser, armTok);
+            if (!arm.block) return nullptr;
+            matchNode->arms.push_back(std::move(arm));
+        }
+
+        parser.consume(TokenType::Delimiter, "}");
+        return matchNode;
+    }
+
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include "../AST.hh"
+#include "../../Token.hh"
+#include "../Parser.hh"
+#include <memory>
+
+namespace MatchStatementExpression {
+    std::unique_ptr<ASTNode> Parse(Parser& parser);
+}
@@ -11,7 +11,7 @@
 int GetPrecedence(const Token& tok) {
    static std::map<std::string, int> prec = {
        {"=", 1}, {":=", 1}, 
-       {"||", 2}, {"or", 2}, 
+       {"?", 2}, {"||", 2}, {"or", 2}, 
        {"&&", 3}, {"and", 3},
        {"|", 4},
        {"^", 5},
@@ -19,8 +19,8 @@ int GetPrecedence(const Token& tok) {
        {"==", 7}, {"!=", 7},
        {"<", 8}, {"<=", 8}, {">", 8}, {">=", 8},
        {"<<", 9}, {">>", 9},
-       {"+", 10}, {"-", 10},
-       {"*", 11}, {"/", 11}, {"%", 11}
+       {"+", 10}, {"-", 10}, {"+%", 10}, {"-%", 10},
+       {"*", 11}, {"/", 11}, {"%", 11}, {"*%", 11}
    };
    if ((tok.type == TokenType::Operator || tok.type == TokenType::Keyword) && prec.count(tok.value))
        return prec[tok.value];
@@ -177,6 +177,12 @@ namespace NumberExpression {
                return nullptr;
            }
 
+           if (tok.value == "?") {
+               left = ParseTernary(parser, std::move(left), stopTokens, hasNumbers, hasStrings);
+               if (!left) return nullptr;
+               continue;
+           }
+
            parser.advance();
            int nextPrec = IsRightAssociative(tok) ? tokPrec : tokPrec + 1;
            auto right = ParseBinary(parser, nextPrec, stopTokens, hasNumbers, hasStrings);
@@ -207,6 +213,48 @@ namespace NumberExpression {
        return left;
    }
 
+   // cond ? a : b, right-associative; the arms decide the type, not the condition
+   std::unique_ptr<ASTNode> ParseTernary(Parser& parser, std::unique_ptr<ASTNode> condition, const std::set<std::string>& stopTokens, bool& hasNumbers, bool& hasStrings) {
+       Token questionTok = parser.advance();
+
+       bool armNumbers = false;
+       bool armStrings = false;
+       auto thenExpr = ParseBinary(parser, 0, {":"}, armNumbers, armStrings);
+       if (!thenExpr) {
+           Write("Parser", "Invalid true branch in conditional expression at line " +
+                 std::to_string(questionTok.line) + ", column " + std::to_string(questionTok.column),
+                 2, true, true, "");
+           return nullptr;
+       }
+
+       if (parser.peek().value != ":") {
+           Write("Parser", "Expected ':' in conditional expression at line " +
+                 std::to_string(parser.peek().line) + ", column " + std::to_string(parser.peek().column),
+                 2, true, true, "");
+           return nullptr;
+       }
+       parser.advance();
+
+       auto elseExpr = ParseBinary(parser, GetPrecedence(questionTok), stopTokens, armNumbers, armStrings);
+       if (!elseExpr) {
+           Write("Parser", "Invalid false branch in conditional expression at line " +
+                 std::to_string(questionTok.line) + ", column " + std::to_string(questionTok.column),
+                 2, true, true, "");
+           return nullptr;
+       }
+
+       hasNumbers = armNumbers;
+       hasStrings = armStrings;
+
+       auto node = std::make_unique<TernaryNode>();
+       node->type = NodeType::Ternary;
+       node->token = questionTok;
+       node->condition = std::move(condition);
+       node->thenExpr = std::move(thenExpr);
+       node->elseExpr = std::move(elseExpr);
+       return node;
+   }
+
    std::unique_ptr<ASTNode> ParseUnary(Parser& parser, const std::set<std::string>& stopTokens, bool& hasNumbers, bool& hasStrings) {
        const Token& tok = parser.peek();
        
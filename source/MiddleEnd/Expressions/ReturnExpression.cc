@@ -4,10 +4,12 @@
 
 namespace ReturnExpression {
     std::unique_ptr<ASTNode> Parse(Parser& parser) {
-        parser.advance();
+        Token retTok = parser.advance();
 
         auto node = std::make_unique<ReturnNode>();
         node->type = NodeType::Return;
+        node->token = retTok;
+        node->isBecome = retTok.value == "become";
 
         const Token& next = parser.peek();
         if (!(next.type == TokenType::Delimiter &&
@@ -23,6 +25,12 @@ namespace ReturnExpression {
             }
         }
 
+        if (node->isBecome && (!node->value || node->value->type != NodeType::FunctionCall)) {
+            Write("Parser", "'become' must be followed by a function call at line " +
+                  std::to_string(retTok.line) + ", column " + std::to_string(retTok.column), 2, true, true, "");
+            return nullptr;
+        }
+
         return node;
     }
 }
@@ -0,0 +1,956 @@
+#include "LoopTransform.hh"
+#include "../Miscellaneous/LoggerHandler/LoggerFile.hh"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace LoopTransform {
+
+    // coefficient of a loop variable multiplied by a non-literal invariant, e.g. `i * n`
+    static const long symbolicCoeff = std::numeric_limits<long>::max();
+    static const long defaultTileSize = 32;
+
+    // calls the optimiser can treat as side-effect free
+    static const std::set<std::string> pureBuiltins = {
+        "sqrt", "fabs", "floor", "ceil", "round", "trunc", "exp", "exp2", "log", "log2", "log10",
+        "sin", "cos", "tan", "fpow", "fmin", "fmax", "copysign", "fma"
+    };
+
+    struct Affine {
+        std::map<std::string, long> coeffs;
+        long constant = 0;
+        bool symbolic = false;
+    };
+
+    struct LoopInfo {
+        ForNode* node;
+        std::string var;
+        const ASTNode* lower;
+        const ASTNode* upper;
+        std::optional<long> trips;
+    };
+
+    struct Access {
+        std::string array;
+        const ASTNode* index;
+        bool write;
+    };
+
+    struct BodySummary {
+        std::vector<Access> accesses;
+        std::set<std::string> locals;
+        std::set<std::string> scalarWrites;
+        bool supported = true;
+    };
+
+    struct Context {
+        std::set<std::string> aliasable;  // array parameters without `restrict`
+        const std::set<std::string>* userFunctions = nullptr;  // functions the program defines, never assumed pure
+        bool autoTransform = false;
+        bool verbose = false;
+    };
+
+    static int LineOf(const ForNode* loop) {
+        return loop->init ? loop->init->token.line : 0;
+    }
+
+    static long AddCoeff(long a, long b) {
+        return (a == symbolicCoeff || b == symbolicCoeff) ? symbolicCoeff : a + b;
+    }
+
+    static long ScaleCoeff(long coeff, long scale) {
+        if (coeff == 0 || scale == 0) return 0;
+        return (coeff == symbolicCoeff || scale == symbolicCoeff) ? symbolicCoeff : coeff * scale;
+    }
+
+    static std::optional<Affine> ToAffine(const ASTNode* expr, const std::set<std::string>& loopVars) {
+        if (!expr) {
+            return std::nullopt;
+        }
+
+        if (expr->type == NodeType::Number) {
+            double value = static_cast<const NumberNode*>(expr)->value;
+            if (value != static_cast<double>(static_cast<long>(value))) {
+                return std::nullopt;
+            }
+            Affine result;
+            result.constant = static_cast<long>(value);
+            return result;
+        }
+        if (expr->type == NodeType::Identifier) {
+            const std::string& name = static_cast<const IdentifierNode*>(expr)->name;
+            Affine result;
+            if (loopVars.count(name)) {
+                result.coeffs[name] = 1;
+            } else {
+                result.symbolic = true;
+            }
+            return result;
+        }
+        if (expr->type == NodeType::Paren) {
+            return ToAffine(static_cast<const ParenNode*>(expr)->inner.get(), loopVars);
+        }
+        if (expr->type == NodeType::UnaryOp) {
+            auto* unary = static_cast<const UnaryOpNode*>(expr);
+            auto operand = unary->op == "-" ? ToAffine(unary->operand.get(), loopVars) : std::nullopt;
+            if (!operand) {
+                return std::nullopt;
+            }
+            for (auto& [var, coeff] : operand->coeffs) {
+                coeff = ScaleCoeff(coeff, -1);
+            }
+            operand->constant = -operand->constant;
+            return operand;
+        }
+        if (expr->type != NodeType::BinaryOp) {
+            return std::nullopt;
+        }
+
+        auto* binary = static_cast<const BinaryOpNode*>(expr);
+        auto left = ToAffine(binary->left.get(), loopVars);
+        auto right = ToAffine(binary->right.get(), loopVars);
+        if (!left || !right) {
+            return std::nullopt;
+        }
+
+        if (binary->op == "+" || binary->op == "-") {
+            long sign = binary->op == "+" ? 1 : -1;
+            for (const auto& [var, coeff] : right->coeffs) {
+                left->coeffs[var] = AddCoeff(left->coeffs[var], ScaleCoeff(coeff, sign));
+            }
+            left->constant += sign * right->constant;
+            left->symbolic = left->symbolic || right->symbolic;
+        } else if (binary->op == "*") {
+            if (!left->coeffs.empty() && !right->coeffs.empty()) {
+                return std::nullopt;
+            }
+            Affine& term = left->coeffs.empty() ? *right : *left;
+            const Affine& factor = left->coeffs.empty() ? *left : *right;
+            long scale = factor.symbolic ? symbolicCoeff : factor.constant;
+            for (auto& [var, coeff] : term.coeffs) {
+                coeff = ScaleCoeff(coeff, scale);
+            }
+            term.constant *= factor.constant;
+            term.symbolic = term.symbolic || factor.symbolic;
+            left = term;
+        } else {
+            return std::nullopt;
+        }
+
+        for (auto it = left->coeffs.begin(); it != left->coeffs.end();) {
+            it = it->second == 0 ? left->coeffs.erase(it) : std::next(it);
+        }
+        return left;
+    }
+
+    static void SummarizeExpression(const ASTNode* expr, BodySummary& summary, const Context& ctx) {
+        if (!expr) {
+            return;
+        }
+
+        switch (expr->type) {
+            case NodeType::Number:
+            case NodeType::Float:
+            case NodeType::String:
+            case NodeType::Character:
+            case NodeType::Boolean:
+            case NodeType::Identifier:
+                return;
+            case NodeType::Paren:
+                SummarizeExpression(static_cast<const ParenNode*>(expr)->inner.get(), summary, ctx);
+                return;
+            case NodeType::BinaryOp: {
+                auto* binary = static_cast<const BinaryOpNode*>(expr);
+                SummarizeExpression(binary->left.get(), summary, ctx);
+                SummarizeExpression(binary->right.get(), summary, ctx);
+                return;
+            }
+            case NodeType::UnaryOp: {
+                auto* unary = static_cast<const UnaryOpNode*>(expr);
+                if (unary->op == "++" || unary->op == "--") {
+                    summary.supported = false;
+                }
+                SummarizeExpression(unary->operand.get(), summary, ctx);
+                return;
+            }
+            case NodeType::Cast:
+                SummarizeExpression(static_cast<const CastNode*>(expr)->expr.get(), summary, ctx);
+                return;
+            case NodeType::Ternary: {
+                auto* ternary = static_cast<const TernaryNode*>(expr);
+                SummarizeExpression(ternary->condition.get(), summary, ctx);
+                SummarizeExpression(ternary->thenExpr.get(), summary, ctx);
+                SummarizeExpression(ternary->elseExpr.get(), summary, ctx);
+                return;
+            }
+            case NodeType::ArrayAccess: {
+                auto* access = static_cast<const ArrayAccessNode*>(expr);
+                summary.accesses.push_back({access->identifier, access->expr.get(), false});
+                SummarizeExpression(access->expr.get(), summary, ctx);
+                return;
+            }
+            case NodeType::Array:
+                for (const auto& element : static_cast<const ArrayNode*>(expr)->elements) {
+                    SummarizeExpression(element.get(), summary, ctx);
+                }
+                return;
+            case NodeType::FunctionCall: {
+                auto* call = static_cast<const FunctionCallNode*>(expr);
+                // a program function of the same name shadows the builtin and may have side effects
+                if (!pureBuiltins.count(call->name) || ctx.userFunctions->count(call->name)) {
+                    summary.supported = false;
+                }
+                for (const auto& arg : call->arguments) {
+                    SummarizeExpression(arg.get(), summary, ctx);
+                }
+                return;
+            }
+            default:
+                summary.supported = false;
+        }
+    }
+
+    static void SummarizeBlock(const BlockNode* block, BodySummary& summary, const Context& ctx);
+
+    static void SummarizeStatement(const ASTNode* stmt, BodySummary& summary, const Context& ctx) {
+        switch (stmt->type) {
+            case NodeType::SemiColon:
+                return;
+            case NodeType::Variable: {
+                auto* var = static_cast<const VariableNode*>(stmt);
+                summary.locals.insert(var->name);
+                SummarizeExpression(var->value.get(), summary, ctx);
+                return;
+            }
+            case NodeType::ArrayAssignment: {
+                auto* assign = static_cast<const ArrayAssignmentNode*>(stmt);
+                summary.accesses.push_back({assign->identifier, assign->indexExpr.get(), true});
+                SummarizeExpression(assign->indexExpr.get(), summary, ctx);
+                SummarizeExpression(assign->value.get(), summary, ctx);
+                return;
+            }
+            case NodeType::Assignment:
+            case NodeType::CompoundAssignment: {
+                const ASTNode* left = stmt->type == NodeType::Assignment
+                    ? static_cast<const AssignmentOpNode*>(stmt)->left.get()
+                    : static_cast<const CompoundAssignmentOpNode*>(stmt)->left.get();
+                const ASTNode* right = stmt->type == NodeType::Assignment
+                    ? static_cast<const AssignmentOpNode*>(stmt)->right.get()
+                    : static_cast<const CompoundAssignmentOpNode*>(stmt)->right.get();
+
+                if (left && left->type == NodeType::Identifier) {
+                    summary.scalarWrites.insert(static_cast<const IdentifierNode*>(left)->name);
+                } else if (left && left->type == NodeType::ArrayAccess) {
+                    auto* access = static_cast<const ArrayAccessNode*>(left);
+                    summary.accesses.push_back({access->identifier, access->expr.get(), true});
+                    SummarizeExpression(access->expr.get(), summary, ctx);
+                } else {
+                    summary.supported = false;
+                }
+                SummarizeExpression(right, summary, ctx);
+                return;
+            }
+            case NodeType::UnaryOp: {
+                auto* unary = static_cast<const UnaryOpNode*>(stmt);
+                if ((unary->op == "++" || unary->op == "--") && unary->operand && unary->operand->type == NodeType::Identifier) {
+                    summary.scalarWrites.insert(static_cast<const IdentifierNode*>(unary->operand.get())->name);
+                } else {
+                    summary.supported = false;
+                }
+                return;
+            }
+            case NodeType::Block:
+                SummarizeBlock(static_cast<const BlockNode*>(stmt), summary, ctx);
+                return;
+            case NodeType::If: {
+                auto* ifNode = static_cast<const IfNode*>(stmt);
+                for (const auto& branch : ifNode->branches) {
+                    if (branch.condition) {
+                        SummarizeExpression(branch.condition->expression.get(), summary, ctx);
+                    }
+                    SummarizeBlock(branch.block.get(), summary, ctx);
+                }
+                SummarizeBlock(ifNode->elseBlock.get(), summary, ctx);
+                return;
+            }
+            default:
+                // loops, calls, returns and breaks all pin the iteration order
+                summary.supported = false;
+        }
+    }
+
+    static void SummarizeBlock(const BlockNode* block, BodySummary& summary, const Context& ctx) {
+        if (!block) {
+            return;
+        }
+        for (const auto& stmt : block->statements) {
+            if (stmt) {
+                SummarizeStatement(stmt.get(), summary, ctx);
+            }
+        }
+    }
+
+    static bool IsSimpleOperand(const ASTNode* expr) {
+        if (!expr) return false;
+        if (expr->type == NodeType::Identifier) return true;
+        if (expr->type != NodeType::Number) return false;
+        double value = static_cast<const NumberNode*>(expr)->value;
+        return value == static_cast<double>(static_cast<long>(value));
+    }
+
+    static bool IsVariable(const ASTNode* expr, const std::string& name) {
+        return expr && expr->type == NodeType::Identifier && static_cast<const IdentifierNode*>(expr)->name == name;
+    }
+
+    static bool HasAttribute(const ForNode* loop, const std::string& name) {
+        return std::any_of(loop->attributes.begin(), loop->attributes.end(), [&](const AttributeSpec& a) { return a.name == name; });
+    }
+
+    // for (var i = lower; i < upper; i++) with literal or identifier bounds
+    static std::optional<LoopInfo> Canonical(ForNode* loop) {
+        if (!loop->init || loop->init->type != NodeType::Variable || !loop->condition || !loop->increment || !loop->body) {
+            return std::nullopt;
+        }
+        auto* init = static_cast<VariableNode*>(loop->init.get());
+        if (init->arrayExpression || !IsSimpleOperand(init->value.get())) {
+            return std::nullopt;
+        }
+
+        const ASTNode* cond = loop->condition->expression.get();
+        if (!cond || cond->type != NodeType::BinaryOp) {
+            return std::nullopt;
+        }
+        auto* compare = static_cast<const BinaryOpNode*>(cond);
+        if (compare->op != "<" || !IsVariable(compare->left.get(), init->name) || !IsSimpleOperand(compare->right.get())) {
+            return std::nullopt;
+        }
+
+        const ASTNode* step = loop->increment.get();
+        bool unitStep = false;
+        if (step->type == NodeType::UnaryOp) {
+            auto* unary = static_cast<const UnaryOpNode*>(step);
+            unitStep = unary->op == "++" && IsVariable(unary->operand.get(), init->name);
+        } else if (step->type == NodeType::CompoundAssignment) {
+            auto* compound = static_cast<const CompoundAssignmentOpNode*>(step);
+            unitStep = compound->op == "+=" && IsVariable(compound->left.get(), init->name) &&
+                       compound->right && compound->right->type == NodeType::Number &&
+                       static_cast<const NumberNode*>(compound->right.get())->value == 1;
+        }
+        if (!unitStep) {
+            return std::nullopt;
+        }
+
+        LoopInfo info{loop, init->name, init->value.get(), compare->right.get(), std::nullopt};
+        if (info.lower->type == NodeType::Number && info.upper->type == NodeType::Number) {
+            long trips = static_cast<long>(static_cast<const NumberNode*>(info.upper)->value) -
+                         static_cast<long>(static_cast<const NumberNode*>(info.lower)->value);
+            info.trips = std::max(trips, 0L);
+        }
+        return info;
+    }
+
+    // the chain of canonical loops where each body holds nothing but the next loop
+    static std::vector<LoopInfo> CollectNest(ForNode* outer) {
+        std::vector<LoopInfo> nest;
+        std::set<std::string> vars;
+
+        ForNode* current = outer;
+        while (current) {
+            auto info = Canonical(current);
+            if (!info || vars.count(info->var)) {
+                break;
+            }
+            // rectangular only: an inner bound may not move with an enclosing index
+            if ((info->lower->type == NodeType::Identifier && vars.count(static_cast<const IdentifierNode*>(info->lower)->name)) ||
+                (info->upper->type == NodeType::Identifier && vars.count(static_cast<const IdentifierNode*>(info->upper)->name))) {
+                break;
+            }
+            nest.push_back(*info);
+            vars.insert(info->var);
+
+            ForNode* inner = nullptr;
+            for (const auto& stmt : current->body->statements) {
+                if (stmt->type == NodeType::SemiColon) {
+                    continue;
+                }
+                if (inner || stmt->type != NodeType::For) {
+                    inner = nullptr;
+                    break;
+                }
+                inner = static_cast<ForNode*>(stmt.get());
+            }
+            // a loop with its own @tile starts a nest of its own
+            current = inner && !HasAttribute(inner, "tile") ? inner : nullptr;
+        }
+        return nest;
+    }
+
+    // distinct iterations of the nest touch distinct elements, except along at most `allowedMissing` indices
+    static bool Separable(const ASTNode* index, const std::vector<LoopInfo>& nest, size_t allowedMissing) {
+        std::set<std::string> vars;
+        std::map<std::string, std::optional<long>> trips;
+        for (const auto& loop : nest) {
+            vars.insert(loop.var);
+            trips[loop.var] = loop.trips;
+        }
+
+        std::set<std::string> used;
+        if (index->type == NodeType::Array) {
+            for (const auto& element : static_cast<const ArrayNode*>(index)->elements) {
+                auto affine = ToAffine(element.get(), vars);
+                if (!affine || affine->coeffs.size() > 1) {
+                    return false;
+                }
+                for (const auto& [var, coeff] : affine->coeffs) {
+                    if ((coeff != 1 && coeff != -1) || !used.insert(var).second) {
+                        return false;
+                    }
+                }
+            }
+        } else {
+            auto affine = ToAffine(index, vars);
+            if (!affine) {
+                return false;
+            }
+            std::vector<std::pair<long, std::string>> terms;
+            for (const auto& [var, coeff] : affine->coeffs) {
+                if (coeff == symbolicCoeff) {
+                    return false;
+                }
+                terms.push_back({std::labs(coeff), var});
+            }
+            std::sort(terms.begin(), terms.end());
+
+            // mixed radix: each stride must step over everything the smaller ones can reach
+            long extent = 0;
+            for (size_t i = 0; i < terms.size(); ++i) {
+                if (terms[i].first <= extent) {
+                    return false;
+                }
+                used.insert(terms[i].second);
+                if (i + 1 < terms.size()) {
+                    if (!trips[terms[i].second]) {
+                        return false;
+                    }
+                    extent += terms[i].first * std::max(*trips[terms[i].second] - 1, 0L);
+                }
+            }
+        }
+        return nest.size() - used.size() <= allowedMissing;
+    }
+
+    static bool CheckAliasing(const BodySummary& summary, const std::set<std::string>& written, const Context& ctx) {
+        for (const auto& array : written) {
+            if (!ctx.aliasable.count(array)) {
+                continue;
+            }
+            for (const auto& access : summary.accesses) {
+                if (access.array != array && ctx.aliasable.count(access.array)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // every order of the nest's loops computes the same result
+    static bool Permutable(const std::vector<LoopInfo>& nest, const BodySummary& summary, const Context& ctx, std::string& reason) {
+        if (!summary.supported) {
+            reason = "the body contains calls, control flow or nested loops";
+            return false;
+        }
+        for (const auto& name : summary.scalarWrites) {
+            if (!summary.locals.count(name)) {
+                reason = "the body assigns '" + name + "', which lives outside the loop";
+                return false;
+            }
+        }
+
+        std::set<std::string> written;
+        for (const auto& access : summary.accesses) {
+            if (access.write && !summary.locals.count(access.array)) {
+                written.insert(access.array);
+            }
+        }
+        for (const auto& array : written) {
+            std::string key;
+            for (const auto& access : summary.accesses) {
+                if (access.array != array) {
+                    continue;
+                }
+                std::string accessKey = access.index->get();
+                if (key.empty()) {
+                    key = accessKey;
+                } else if (key != accessKey) {
+                    reason = "'" + array + "' is written and accessed through different indices";
+                    return false;
+                }
+                if (!Separable(access.index, nest, 1)) {
+                    reason = "the index into '" + array + "' is not a separable affine function of the loop indices";
+                    return false;
+                }
+            }
+        }
+        if (!CheckAliasing(summary, written, ctx)) {
+            reason = "array parameters may alias; mark them 'restrict'";
+            return false;
+        }
+        return true;
+    }
+
+    enum class Stride { Invariant, Unit, Strided, Unknown };
+
+    static Stride StrideOf(const ASTNode* index, const std::string& var, const std::set<std::string>& vars) {
+        if (index->type == NodeType::Array) {
+            const auto& elements = static_cast<const ArrayNode*>(index)->elements;
+            Stride result = Stride::Invariant;
+            for (size_t i = 0; i < elements.size(); ++i) {
+                auto affine = ToAffine(elements[i].get(), vars);
+                if (!affine) {
+                    return Stride::Unknown;
+                }
+                auto coeff = affine->coeffs.find(var);
+                if (coeff != affine->coeffs.end()) {
+                    bool unit = i + 1 == elements.size() && (coeff->second == 1 || coeff->second == -1);
+                    result = unit && result == Stride::Invariant ? Stride::Unit : Stride::Strided;
+                }
+            }
+            return result;
+        }
+
+        auto affine = ToAffine(index, vars);
+        if (!affine) {
+            return Stride::Unknown;
+        }
+        auto coeff = affine->coeffs.find(var);
+        if (coeff == affine->coeffs.end()) {
+            return Stride::Invariant;
+        }
+        return coeff->second == 1 || coeff->second == -1 ? Stride::Unit : Stride::Strided;
+    }
+
+    static std::pair<int, int> StrideScore(const std::vector<LoopInfo>& nest, const BodySummary& summary, const std::string& var) {
+        std::set<std::string> vars;
+        for (const auto& loop : nest) {
+            vars.insert(loop.var);
+        }
+        int strided = 0;
+        int unit = 0;
+        for (const auto& access : summary.accesses) {
+            if (summary.locals.count(access.array)) {
+                continue;
+            }
+            Stride stride = StrideOf(access.index, var, vars);
+            strided += stride == Stride::Strided;
+            unit += stride == Stride::Unit;
+        }
+        return {strided, unit};
+    }
+
+    // rotate the loop headers so that nest[from] becomes the innermost loop
+    static void MoveInnermost(std::vector<LoopInfo>& nest, size_t from) {
+        struct Header {
+            std::unique_ptr<ASTNode> init;
+            std::unique_ptr<ConditionNode> condition;
+            std::unique_ptr<ASTNode> increment;
+            std::vector<AttributeSpec> attributes;
+        };
+
+        std::vector<Header> headers;
+        for (size_t i = from; i < nest.size(); ++i) {
+            ForNode* loop = nest[i].node;
+            headers.push_back({std::move(loop->init), std::move(loop->condition), std::move(loop->increment), std::move(loop->attributes)});
+        }
+        std::rotate(headers.begin(), headers.begin() + 1, headers.end());
+
+        std::vector<LoopInfo> infos(nest.begin() + from, nest.end());
+        std::rotate(infos.begin(), infos.begin() + 1, infos.end());
+
+        for (size_t i = from; i < nest.size(); ++i) {
+            ForNode* loop = nest[i].node;
+            Header& header = headers[i - from];
+            loop->init = std::move(header.init);
+            loop->condition = std::move(header.condition);
+            loop->increment = std::move(header.increment);
+            loop->attributes = std::move(header.attributes);
+            nest[i] = infos[i - from];
+            nest[i].node = loop;
+        }
+    }
+
+    static std::unique_ptr<ASTNode> MakeNumber(long value, const Token& token) {
+        auto node = std::make_unique<NumberNode>();
+        node->type = NodeType::Number;
+        node->token = token;
+        node->value = static_cast<double>(value);
+        return node;
+    }
+
+    static std::unique_ptr<ASTNode> MakeIdentifier(const std::string& name, const Token& token) {
+        auto node = std::make_unique<IdentifierNode>();
+        node->type = NodeType::Identifier;
+        node->token = token;
+        node->name = name;
+        return node;
+    }
+
+    static std::unique_ptr<ASTNode> MakeBinary(const std::string& op, std::unique_ptr<ASTNode> left, std::unique_ptr<ASTNode> right, const Token& token) {
+        auto node = std::make_unique<BinaryOpNode>();
+        node->type = NodeType::BinaryOp;
+        node->token = token;
+        node->op = op;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+    }
+
+    static std::unique_ptr<ASTNode> CloneOperand(const ASTNode* operand) {
+        if (operand->type == NodeType::Identifier) {
+            return MakeIdentifier(static_cast<const IdentifierNode*>(operand)->name, operand->token);
+        }
+        return MakeNumber(static_cast<long>(static_cast<const NumberNode*>(operand)->value), operand->token);
+    }
+
+    static std::unique_ptr<BlockNode> MakeBlock(std::unique_ptr<ASTNode> stmt, const Token& token) {
+        auto block = std::make_unique<BlockNode>();
+        block->type = NodeType::Block;
+        block->token = token;
+        block->statements.push_back(std::move(stmt));
+        return block;
+    }
+
+    // strip-mine the outer sizes.size() loops and hoist the tile loops above the point loops
+    static void Tile(std::unique_ptr<ASTNode>& slot, std::vector<LoopInfo>& nest, const std::vector<long>& sizes) {
+        std::vector<std::unique_ptr<ForNode>> tiles;
+
+        for (size_t l = 0; l < sizes.size(); ++l) {
+            LoopInfo& loop = nest[l];
+            auto* init = static_cast<VariableNode*>(loop.node->init.get());
+            auto* compare = static_cast<BinaryOpNode*>(loop.node->condition->expression.get());
+            const Token& token = init->token;
+            std::string tileVar = loop.var + ".tile";
+            long size = sizes[l];
+
+            // the point loop stops at the end of its tile, or at the original bound for a partial last tile
+            std::unique_ptr<ASTNode> pointBound;
+            if (loop.trips && *loop.trips % size == 0) {
+                pointBound = MakeBinary("+", MakeIdentifier(tileVar, token), MakeNumber(size, token), token);
+            } else {
+                auto clamp = std::make_unique<TernaryNode>();
+                clamp->type = NodeType::Ternary;
+                clamp->token = token;
+                clamp->condition = MakeBinary("<", MakeBinary("+", MakeIdentifier(tileVar, token), MakeNumber(size, token), token), CloneOperand(loop.upper), token);
+                clamp->thenExpr = MakeBinary("+", MakeIdentifier(tileVar, token), MakeNumber(size, token), token);
+                clamp->elseExpr = CloneOperand(loop.upper);
+                pointBound = std::move(clamp);
+            }
+
+            auto tileInit = std::make_unique<VariableNode>();
+            tileInit->type = NodeType::Variable;
+            tileInit->token = token;
+            tileInit->name = tileVar;
+            tileInit->varType = init->varType;
+            tileInit->value = std::move(init->value);
+            init->value = MakeIdentifier(tileVar, token);
+
+            auto tileCondition = std::make_unique<ConditionNode>();
+            tileCondition->type = NodeType::Condition;
+            tileCondition->token = token;
+            tileCondition->expression = MakeBinary("<", MakeIdentifier(tileVar, token), std::move(compare->right), token);
+            compare->right = std::move(pointBound);
+
+            auto tileStep = std::make_unique<CompoundAssignmentOpNode>();
+            tileStep->type = NodeType::CompoundAssignment;
+            tileStep->token = token;
+            tileStep->op = "+=";
+            tileStep->left = MakeIdentifier(tileVar, token);
+            tileStep->right = MakeNumber(size, token);
+
+            auto tile = std::make_unique<ForNode>();
+            tile->token = loop.node->token;
+            tile->init = std::move(tileInit);
+            tile->condition = std::move(tileCondition);
+            tile->increment = std::move(tileStep);
+            tiles.push_back(std::move(tile));
+        }
+
+        std::unique_ptr<ASTNode> inner = std::move(slot);
+        for (size_t l = tiles.size(); l-- > 0;) {
+            tiles[l]->body = MakeBlock(std::move(inner), tiles[l]->token);
+            inner = std::move(tiles[l]);
+        }
+        slot = std::move(inner);
+    }
+
+    static bool FusionCompatible(ForNode* first, ForNode* second, const Context& ctx) {
+        if (!first->attributes.empty() || !second->attributes.empty()) {
+            return false;
+        }
+        auto a = Canonical(first);
+        auto b = Canonical(second);
+        if (!a || !b || a->var != b->var || a->lower->get() != b->lower->get() || a->upper->get() != b->upper->get()) {
+            return false;
+        }
+
+        BodySummary sa, sb;
+        SummarizeBlock(first->body.get(), sa, ctx);
+        SummarizeBlock(second->body.get(), sb, ctx);
+        if (!sa.supported || !sb.supported) {
+            return false;
+        }
+        for (const BodySummary* summary : {&sa, &sb}) {
+            for (const auto& name : summary->scalarWrites) {
+                if (!summary->locals.count(name)) {
+                    return false;
+                }
+            }
+        }
+
+        BodySummary combined;
+        combined.accesses = sa.accesses;
+        combined.accesses.insert(combined.accesses.end(), sb.accesses.begin(), sb.accesses.end());
+
+        std::set<std::string> written;
+        for (const auto& access : sa.accesses) {
+            if (access.write && !sa.locals.count(access.array)) written.insert(access.array);
+        }
+        for (const auto& access : sb.accesses) {
+            if (access.write && !sb.locals.count(access.array)) written.insert(access.array);
+        }
+
+        // iteration x of the fused loop may only touch what iteration x of each original loop touched
+        std::vector<LoopInfo> nest = {*a};
+        for (const auto& array : written) {
+            std::string key;
+            for (const auto& access : combined.accesses) {
+                if (access.array != array) {
+                    continue;
+                }
+                std::string accessKey = access.index->get();
+                if ((!key.empty() && key != accessKey) || !Separable(access.index, nest, 0)) {
+                    return false;
+                }
+                key = accessKey;
+            }
+        }
+        return CheckAliasing(combined, written, ctx);
+    }
+
+    static void FuseAdjacent(std::vector<std::unique_ptr<ASTNode>>& statements, const Context& ctx) {
+        for (size_t i = 0; i < statements.size(); ++i) {
+            if (!statements[i] || statements[i]->type != NodeType::For) {
+                continue;
+            }
+            auto* first = static_cast<ForNode*>(statements[i].get());
+
+            while (true) {
+                size_t next = i + 1;
+                while (next < statements.size() && statements[next] && statements[next]->type == NodeType::SemiColon) {
+                    ++next;
+                }
+                if (next >= statements.size() || !statements[next] || statements[next]->type != NodeType::For) {
+                    break;
+                }
+                auto* second = static_cast<ForNode*>(statements[next].get());
+                if (!FusionCompatible(first, second, ctx)) {
+                    break;
+                }
+
+                // each body keeps its own scope so their locals cannot collide
+                auto fused = std::make_unique<BlockNode>();
+                fused->type = NodeType::Block;
+                fused->token = first->body->token;
+                fused->statements.push_back(std::move(first->body));
+                fused->statements.push_back(std::move(second->body));
+                first->body = std::move(fused);
+
+                if (ctx.verbose) {
+                    Write("Loop Transform", "Fused loops at lines " + std::to_string(LineOf(first)) + " and " + std::to_string(LineOf(second)), 0, true, true, "");
+                }
+                statements.erase(statements.begin() + next);
+            }
+        }
+    }
+
+    static void ProcessBlock(std::vector<std::unique_ptr<ASTNode>>& statements, const Context& ctx);
+
+    static void ProcessLoop(std::unique_ptr<ASTNode>& slot, const Context& ctx) {
+        auto* loop = static_cast<ForNode*>(slot.get());
+        int line = LineOf(loop);
+
+        std::optional<AttributeSpec> tile;
+        for (auto it = loop->attributes.begin(); it != loop->attributes.end(); ++it) {
+            if (it->name == "tile") {
+                tile = *it;
+                loop->attributes.erase(it);
+                break;
+            }
+        }
+
+        std::vector<long> sizes;
+        if (tile) {
+            std::string location = " at line " + std::to_string(tile->token.line) + ", column " + std::to_string(tile->token.column);
+            if (tile->args.empty()) {
+                Write("Loop Transform", "'@tile' needs one tile size per loop to tile" + location, 2, true, true, "");
+                return;
+            }
+            for (const auto& arg : tile->args) {
+                if (arg.empty() || arg.size() > 6 || arg.find_first_not_of("0123456789") != std::string::npos || std::stol(arg) < 2) {
+                    Write("Loop Transform", "'@tile' sizes must be integers of at least 2, got '" + arg + "'" + location, 2, true, true, "");
+                    return;
+                }
+                sizes.push_back(std::stol(arg));
+            }
+        }
+
+        std::vector<LoopInfo> nest = CollectNest(loop);
+        bool analysed = false;
+
+        if (tile || (ctx.autoTransform && nest.size() >= 2)) {
+            BodySummary summary;
+            if (!nest.empty()) {
+                SummarizeBlock(nest.back().node->body.get(), summary, ctx);
+            }
+            std::string reason = "it is not a canonical 'for (var i = a; i < b; i++)' loop";
+            analysed = !nest.empty() && Permutable(nest, summary, ctx, reason);
+
+            if (tile && sizes.size() > nest.size()) {
+                Write("Loop Transform", "Ignoring '@tile' on the loop at line " + std::to_string(line) + ": " + std::to_string(sizes.size()) +
+                      " sizes given but the perfect nest is only " + std::to_string(nest.size()) + " deep", 1, true, true, "");
+            } else if (tile && !analysed) {
+                Write("Loop Transform", "Ignoring '@tile' on the loop at line " + std::to_string(line) + ": " + reason, 1, true, true, "");
+            } else if (tile) {
+                Tile(slot, nest, sizes);
+                if (ctx.verbose) {
+                    Write("Loop Transform", "Tiled " + std::to_string(sizes.size()) + " loop(s) of the nest at line " + std::to_string(line), 0, true, true, "");
+                }
+            } else if (analysed) {
+                // put the index with the fewest strided accesses innermost
+                size_t best = nest.size() - 1;
+                auto bestScore = StrideScore(nest, summary, nest[best].var);
+                for (size_t l = 0; l + 1 < nest.size(); ++l) {
+                    auto score = StrideScore(nest, summary, nest[l].var);
+                    if (score.first < bestScore.first || (score.first == bestScore.first && score.second > bestScore.second)) {
+                        best = l;
+                        bestScore = score;
+                    }
+                }
+                if (best != nest.size() - 1) {
+                    std::string var = nest[best].var;
+                    MoveInnermost(nest, best);
+                    if (ctx.verbose) {
+                        Write("Loop Transform", "Interchanged the nest at line " + std::to_string(line) + " so '" + var + "' runs innermost", 0, true, true, "");
+                    }
+                }
+
+                // blocking pays off when accesses still stride in the innermost loop, or when a deep nest reuses data across loops
+                bool bounded = std::all_of(nest.begin(), nest.end(), [](const LoopInfo& l) { return l.trips && *l.trips >= 2 * defaultTileSize; });
+                if (bounded && (bestScore.first > 0 || nest.size() >= 3)) {
+                    Tile(slot, nest, std::vector<long>(nest.size(), defaultTileSize));
+                    if (ctx.verbose) {
+                        Write("Loop Transform", "Tiled the nest at line " + std::to_string(line) + " by " + std::to_string(defaultTileSize), 0, true, true, "");
+                    }
+                }
+            }
+        }
+
+        // a permutable nest has no loops left in its body
+        if (!analysed && loop->body) {
+            ProcessBlock(loop->body->statements, ctx);
+        }
+    }
+
+    static void ProcessBlock(std::vector<std::unique_ptr<ASTNode>>& statements, const Context& ctx) {
+        if (ctx.autoTransform) {
+            FuseAdjacent(statements, ctx);
+        }
+
+        for (auto& stmt : statements) {
+            if (!stmt) {
+                continue;
+            }
+            switch (stmt->type) {
+                case NodeType::For:
+                    ProcessLoop(stmt, ctx);
+                    break;
+                case NodeType::While: {
+                    auto* whileNode = static_cast<WhileNode*>(stmt.get());
+                    if (whileNode->block) ProcessBlock(whileNode->block->statements, ctx);
+                    break;
+                }
+                case NodeType::ForEach: {
+                    auto* forEach = static_cast<ForEachNode*>(stmt.get());
+                    if (forEach->body) ProcessBlock(forEach->body->statements, ctx);
+                    break;
+                }
+                case NodeType::Block:
+                    ProcessBlock(static_cast<BlockNode*>(stmt.get())->statements, ctx);
+                    break;
+                case NodeType::If: {
+                    auto* ifNode = static_cast<IfNode*>(stmt.get());
+                    for (auto& branch : ifNode->branches) {
+                        if (branch.block) ProcessBlock(branch.block->statements, ctx);
+                    }
+                    if (ifNode->elseBlock) ProcessBlock(ifNode->elseBlock->statements, ctx);
+                    break;
+                }
+                case NodeType::Match: {
+                    auto* match = static_cast<MatchNode*>(stmt.get());
+                    for (auto& arm : match->arms) {
+                        if (arm.block) ProcessBlock(arm.block->statements, ctx);
+                    }
+                    if (match->defaultBlock) ProcessBlock(match->defaultBlock->statements, ctx);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    void Run(ProgramNode* root, bool autoTransform, bool verbose) {
+        if (!root) {
+            return;
+        }
+
+        std::vector<FunctionNode*> functions;
+        std::set<std::string> userFunctions;
+        for (auto& stmt : root->statements) {
+            FunctionNode* func = nullptr;
+            if (stmt && stmt->type == NodeType::Function) {
+                func = static_cast<FunctionNode*>(stmt.get());
+            } else if (stmt && stmt->type == NodeType::ExpressionStatement) {
+                auto* expr = static_cast<ExpressionStatementNode*>(stmt.get());
+                if (expr->expression && expr->expression->type == NodeType::Function) {
+                    func = static_cast<FunctionNode*>(expr->expression.get());
+                }
+            }
+            if (func) {
+                functions.push_back(func);
+                userFunctions.insert(func->name);
+            }
+        }
+
+        for (FunctionNode* func : functions) {
+            if (!func->body) {
+                continue;
+            }
+
+            Context ctx;
+            ctx.autoTransform = autoTransform;
+            ctx.verbose = verbose;
+            ctx.userFunctions = &userFunctions;
+            for (size_t i = 0; i < func->params.size(); ++i) {
+                bool isRestrict = i < func->restrictParams.size() && func->restrictParams[i];
+                if (std::get<2>(func->params[i]) > 0 && !isRestrict) {
+                    ctx.aliasable.insert(std::get<0>(func->params[i]));
+                }
+            }
+            ProcessBlock(func->body->statements, ctx);
+        }
+    }
+
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include "AST.hh"
+#include <memory>
+
+namespace LoopTransform {
+    // honours @tile on every for nest; with autoTransform (-floop-tiling) also fuses adjacent loops,
+    // interchanges nests to unit stride and tiles the ones that still walk memory with a stride
+    void Run(ProgramNode* root, bool autoTransform, bool verbose);
+}
@@ -22,6 +22,20 @@ namespace ConditionNodeContainer {
         condNode->type = NodeType::Condition;
         condNode->token = parser.peek(-1);
         condNode->expression = std::move(expr);
+
+        // `if likely (x)` parses as a call wrapping the whole condition; hoist it onto the branch
+        ASTNode* hint = condNode->expression.get();
+        if (hint->type == NodeType::Paren && static_cast<ParenNode*>(hint)->inner) {
+            hint = static_cast<ParenNode*>(hint)->inner.get();
+        }
+        if (hint->type == NodeType::FunctionCall) {
+            auto* call = static_cast<FunctionCallNode*>(hint);
+            if ((call->name == "likely" || call->name == "unlikely") && call->arguments.size() == 1) {
+                condNode->likelihood = call->name == "likely" ? 1 : -1;
+                auto inner = std::move(call->arguments[0]);
+                condNode->expression = std::move(inner);
+            }
+        }
         return condNode;
     }
 }
\ No newline at end of file
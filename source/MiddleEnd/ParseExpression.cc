@@ -38,15 +38,31 @@ std::unique_ptr<ASTNode> Main::ParseExpression(Parser& parser, int precedence, c
     if (tok.value == "while") {
         return WhileStatementExpression::Parse(parser);
     }
+    if (tok.value == "match") {
+        return MatchStatementExpression::Parse(parser);
+    }
     if (tok.value == "for") {
         return ForStatementExpression::Parse(parser);
     }
-    if (tok.value == "ret" || tok.value == "return") {
+    if (tok.value == "ret" || tok.value == "return" || tok.value == "become") {
         return ReturnExpression::Parse(parser);
     }
     if (tok.value == "func") {
         return FunctionExpression::Parse(parser);
     }
+    if (tok.type == TokenType::Delimiter && tok.value == "@") {
+        return AttributeExpression::Parse(parser);
+    }
+    if (tok.value == "export") {
+        parser.advance();
+        const Token& next = parser.peek();
+        if (next.value != "func" && next.value != "inline" && next.value != "always_inline") {
+            Write("Parser", "Expected function after 'export' at line " + std::to_string(tok.line) +
+                  ", column " + std::to_string(tok.column), 2, true, true, "");
+            return nullptr;
+        }
+        return Main::ParseExpression(parser, precedence, stopTokens);
+    }
     if (tok.value == "=") {
         return AssignmentExpression::Parse(parser);
     }
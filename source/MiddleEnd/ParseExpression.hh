@@ -15,10 +15,12 @@
 #include "Expressions/VariableExpression.hh"
 #include "Expressions/IfStatementExpression.hh"
 #include "Expressions/WhileStatementExpression.hh"
+#include "Expressions/MatchStatementExpression.hh"
 #include "Expressions/ForStatementExpression.hh"
 #include "Expressions/ReturnExpression.hh"
 #include "Expressions/FunctionExpression.hh"
 #include "Expressions/InlineExpression.hh"
+#include "Expressions/AttributeExpression.hh"
 // nodes
 #include "Nodes/BlockNode.hh"
 #include "Nodes/ConditionNode.hh"
@@ -1,6 +1,6 @@
 #include "Token.hh"
 
-std::set<std::string> Keywords = {"var", "if", "while", "func", "ret", "inline", "always_inline", "break", "for", "foreach"};
+std::set<std::string> Keywords = {"var", "if", "while", "func", "ret", "inline", "always_inline", "break", "for", "foreach", "export", "become", "match"};
 
 std::set<std::string> Operators = {
     "+", "-", "*", "/", "%",     // arithmetic
@@ -10,12 +10,15 @@ std::set<std::string> Operators = {
     "<", "<=", ">", ">=",        // relational
     "++", "--",                  // increment / decrement
     "+=", "-=", "*=", "/=" ,     // compount operators
+    "+%", "-%", "*%",            // wrapping arithmetic
     "<<", ">>", "|", "&", "^",    // bitwise operators
-    "$", "#", "%"
+    "$", "#", "%",
+    "?",                         // conditional expression
+    "=>"                         // match arms
 };
 
 std::set<char> Delimiters = {
-    '(', ')', '{', '}', '[', ']', ',', ';', ':', '.', '\'', '"', '`'
+    '(', ')', '{', '}', '[', ']', ',', ';', ':', '.', '\'', '"', '`', '@'
 };
 
 std::ostream& operator<<(std::ostream& os, const Token& tok) {
@@ -0,0 +1,297 @@
+#include "Tune.hh"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Program.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace {
+    struct Measurement {
+        double Seconds;
+        int Status;
+        std::string Output;
+    };
+
+    std::vector<std::string> ConfigArgs(const TuneConfig& Config) {
+        std::vector<std::string> Args = {"-O" + std::to_string(Config.OptimizationLevel)};
+        if (Config.InlineThreshold >= 0) Args.push_back("-finline-threshold=" + std::to_string(Config.InlineThreshold));
+        if (Config.InlineRounds >= 0) Args.push_back("-finline-rounds=" + std::to_string(Config.InlineRounds));
+        Args.push_back(Config.Unroll ? "-funroll-loops" : "-fno-unroll-loops");
+        Args.push_back(Config.Vectorize ? "-fvectorize" : "-fno-vectorize");
+        Args.push_back(Config.SLPVectorize ? "-fslp-vectorize" : "-fno-slp-vectorize");
+        Args.push_back(Config.FastMath ? "-ffast-math" : "-fno-fast-math");
+        return Args;
+    }
+
+    std::string Shell(const std::string& Command) {
+#ifdef _WIN32
+        // cmd.exe drops the first and last quote of a line that starts with one
+        return "\"" + Command + "\"";
+#else
+        return Command;
+#endif
+    }
+
+    // the candidate is started directly rather than through a shell, so timings cover the program alone;
+    // returns its exit status, negative when it could not be started or crashed
+    int RunCandidate(const fs::path& Binary, const fs::path& Output) {
+        std::string Program = Binary.string();
+        std::string OutputPath = Output.string();
+        std::optional<llvm::StringRef> Redirects[] = {std::nullopt, llvm::StringRef(OutputPath), std::nullopt};
+        return llvm::sys::ExecuteAndWait(Program, {Program}, std::nullopt, Redirects);
+    }
+
+    std::string Describe(const TuneConfig& Config) {
+        std::string Text;
+        for (const auto& Arg : ConfigArgs(Config)) {
+            Text += (Text.empty() ? "" : " ") + Arg;
+        }
+        return Text;
+    }
+
+    std::string ReadFile(const fs::path& Path) {
+        std::ifstream File(Path, std::ios::binary);
+        std::stringstream Buffer;
+        Buffer << File.rdbuf();
+        return Buffer.str();
+    }
+
+    // a .vxtune stays usable after edits, but verbose builds say when it was tuned for other source
+    std::string SourceHash(const fs::path& InputFile) {
+        std::stringstream Hex;
+        Hex << std::hex << std::hash<std::string>{}(ReadFile(InputFile));
+        return Hex.str();
+    }
+
+    bool ParseBool(const std::string& Value, bool& Out) {
+        if (Value == "1" || Value == "true") { Out = true; return true; }
+        if (Value == "0" || Value == "false") { Out = false; return true; }
+        return false;
+    }
+
+    bool ParseInt(const std::string& Value, int Low, int High, int& Out) {
+        size_t Digits = Value.size() > 1 && Value[0] == '-' ? 1 : 0;
+        if (Value.size() == Digits || Value.size() > 7 || !std::all_of(Value.begin() + Digits, Value.end(), ::isdigit)) return false;
+        int Parsed = std::atoi(Value.c_str());
+        if (Parsed < Low || Parsed > High) return false;
+        Out = Parsed;
+        return true;
+    }
+}
+
+fs::path TuneFileFor(const fs::path& InputFile) {
+    fs::path File = InputFile;
+    return File.replace_extension(".vxtune");
+}
+
+void ApplyTuneFile(CLIObject* In, const std::set<std::string>& Explicit) {
+    fs::path File = TuneFileFor(In->InputFile);
+    if (!fs::exists(File)) return;
+
+    std::ifstream Stream(File);
+    std::string Line;
+    unsigned LineNo = 0;
+    while (std::getline(Stream, Line)) {
+        LineNo++;
+        if (!Line.empty() && Line.back() == '\r') Line.pop_back();
+        if (Line.empty() || Line[0] == '#') continue;
+
+        size_t Eq = Line.find('=');
+        std::string Key = Line.substr(0, Eq);
+        std::string Value = Eq == std::string::npos ? "" : Line.substr(Eq + 1);
+
+        if (Key == "source") {
+            if (Value != SourceHash(In->InputFile)) {
+                Write("CLI", File.filename().string() + " was tuned for an older version of " + In->InputFile.filename().string() + "; rerun 'vexar tune' to refresh it", 0, In->Verbose, true);
+            }
+            continue;
+        }
+        if (Key == "seconds" || Key == "baseline-seconds" || Explicit.count(Key)) continue;
+
+        bool Valid = false;
+        if (Key == "opt")                   Valid = ParseInt(Value, 0, 5, In->OptimizationLevel);
+        else if (Key == "inline-threshold") Valid = ParseInt(Value, -1, 100000, In->InlineThreshold);
+        else if (Key == "inline-rounds")    Valid = ParseInt(Value, -1, 16, In->InlineRounds);
+        else if (Key == "unroll")           Valid = ParseBool(Value, In->Unroll);
+        else if (Key == "vectorize")        Valid = ParseBool(Value, In->Vectorize);
+        else if (Key == "slp-vectorize")    Valid = ParseBool(Value, In->SLPVectorize);
+        else if (Key == "fast-math")        Valid = ParseBool(Value, In->FastMath);
+
+        if (!Valid) {
+            Write("CLI", File.filename().string() + ":" + std::to_string(LineNo) + ": ignoring '" + Line + "'", 1, true, true);
+        }
+    }
+
+    Write("CLI", "Using tuned configuration from " + File.string(), 0, In->Verbose, true);
+}
+
+int RunTuner(CLIObject* In, const char* Argv0) {
+    if (!In->CompilerTarget.empty() || In->RunAfterCompile) {
+        Write("Tune", "vexar tune builds and runs host executables; drop --target and --run", 2, true, true);
+    }
+
+    std::string Self = llvm::sys::fs::getMainExecutable(Argv0, reinterpret_cast<void*>(&RunTuner));
+    if (Self.empty()) Self = Argv0;
+
+    // unique per run, so concurrent tunes of same-named programs keep their candidates apart
+    llvm::SmallString<128> UniqueDir;
+    if (std::error_code Error = llvm::sys::fs::createUniqueDirectory("vexar-tune-" + In->InputFile.stem().string(), UniqueDir)) {
+        Write("Tune", "Failed to create a work directory: " + Error.message(), 2, true, true);
+    }
+    fs::path WorkDir = UniqueDir.str().str();
+
+    std::string Forwarded;
+    for (const auto& Arg : In->TuneArgs) {
+        Forwarded += " \"" + Arg + "\"";
+    }
+
+    unsigned Builds = 0;
+    auto Measure = [&](const TuneConfig& Config) -> std::optional<Measurement> {
+        fs::path Binary = WorkDir / ("candidate-" + std::to_string(Builds++) + ".exe");
+        fs::path Log = WorkDir / "build.log";
+        fs::path Output = WorkDir / "run.out";
+
+        std::string Build = "\"" + Self + "\" \"" + In->InputFile.string() + "\"" + Forwarded;
+        for (const auto& Arg : ConfigArgs(Config)) {
+            Build += " " + Arg;
+        }
+        Build += " --no-tune-file -o \"" + Binary.string() + "\" > \"" + Log.string() + "\" 2>&1";
+
+        if (std::system(Shell(Build).c_str()) != 0 || !fs::exists(Binary)) {
+            Write("Tune", "Build failed with " + Describe(Config) + " (see " + Log.string() + ")", 1, true, true);
+            return std::nullopt;
+        }
+
+        // one untimed run warms the caches and provides the output every candidate must reproduce
+        Measurement Result;
+        Result.Status = RunCandidate(Binary, Output);
+        Result.Output = ReadFile(Output);
+
+        // every timed run has to succeed too, or a crash part-way through would be recorded as a fast time
+        std::vector<double> Times;
+        for (int i = 0; i < In->TuneRuns && Result.Status == 0; i++) {
+            auto Start = std::chrono::high_resolution_clock::now();
+            Result.Status = RunCandidate(Binary, Output);
+            Times.push_back(std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - Start).count());
+        }
+        std::sort(Times.begin(), Times.end());
+        Result.Seconds = Times.empty() ? 0.0 : Times[Times.size() / 2];
+
+        fs::remove(Binary);
+        return Result;
+    };
+
+    // settings given on the command line stay fixed; the search covers the rest
+    const std::set<std::string>& Fixed = In->TuneFixed;
+    TuneConfig Best;
+    if (Fixed.count("opt")) Best.OptimizationLevel = In->OptimizationLevel;
+    if (Fixed.count("inline-threshold")) Best.InlineThreshold = In->InlineThreshold;
+    if (Fixed.count("inline-rounds")) Best.InlineRounds = In->InlineRounds;
+    if (Fixed.count("unroll")) Best.Unroll = In->Unroll;
+    if (Fixed.count("vectorize")) Best.Vectorize = In->Vectorize;
+    if (Fixed.count("slp-vectorize")) Best.SLPVectorize = In->SLPVectorize;
+    if (Fixed.count("fast-math")) Best.FastMath = In->FastMath;
+
+    const std::string BaselineConfig = Describe(Best);
+    std::optional<Measurement> Baseline = Measure(Best);
+    if (!Baseline) {
+        fs::remove_all(WorkDir);
+        Write("Tune", "The program does not build with " + BaselineConfig + "; nothing to tune", 2, true, true);
+    }
+    if (Baseline->Status != 0) {
+        fs::remove_all(WorkDir);
+        Write("Tune", "The program exits with status " + std::to_string(Baseline->Status) + " when built with " + BaselineConfig +
+              "; vexar tune only times runs that exit with 0", 2, true, true);
+    }
+    double BestSeconds = Baseline->Seconds;
+    Write("Tune", Describe(Best) + ": " + std::to_string(BestSeconds * 1000.0) + " ms (baseline)", 0, true, true);
+
+    std::set<std::string> Tried = {Describe(Best)};
+    unsigned Candidates = 1;
+    auto Try = [&](const TuneConfig& Config) {
+        if (!Tried.insert(Describe(Config)).second) return;
+        std::optional<Measurement> Result = Measure(Config);
+        if (!Result) return;
+        Candidates++;
+
+        if (Result->Status != 0) {
+            Write("Tune", Describe(Config) + " exits with status " + std::to_string(Result->Status) + "; rejected", 1, true, true);
+            return;
+        }
+        if (Result->Output != Baseline->Output) {
+            Write("Tune", Describe(Config) + " changes the program's output; rejected", 1, true, true);
+            return;
+        }
+        Write("Tune", Describe(Config) + ": " + std::to_string(Result->Seconds * 1000.0) + " ms", 0, true, true);
+
+        // anything within 2% is run-to-run noise, not a reason to move away from the current choice
+        if (Result->Seconds < BestSeconds * 0.98) {
+            Best = Config;
+            BestSeconds = Result->Seconds;
+        }
+    };
+
+    // one coordinate-descent sweep; the level goes first because every later knob is relative to it
+    for (int Level : {3, 4}) {
+        if (Fixed.count("opt")) break;
+        TuneConfig Config = Best;
+        Config.OptimizationLevel = Level;
+        Try(Config);
+    }
+    if (Best.OptimizationLevel == 3 && !Fixed.count("inline-rounds")) {
+        for (int Rounds : {0, 1, 4}) {
+            TuneConfig Config = Best;
+            Config.InlineRounds = Rounds;
+            Try(Config);
+        }
+    }
+    for (int Threshold : {75, 500, 1000}) {
+        if (Fixed.count("inline-threshold")) break;
+        TuneConfig Config = Best;
+        Config.InlineThreshold = Threshold;
+        Try(Config);
+    }
+    const std::pair<const char*, bool TuneConfig::*> Switches[] = {
+        {"unroll", &TuneConfig::Unroll}, {"vectorize", &TuneConfig::Vectorize},
+        {"slp-vectorize", &TuneConfig::SLPVectorize}, {"fast-math", &TuneConfig::FastMath}
+    };
+    for (const auto& [Key, Knob] : Switches) {
+        if (Fixed.count(Key)) continue;
+        TuneConfig Config = Best;
+        Config.*Knob = !(Config.*Knob);
+        Try(Config);
+    }
+
+    fs::remove_all(WorkDir);
+
+    fs::path File = TuneFileFor(In->InputFile);
+    std::ofstream Out(File);
+    if (!Out.is_open()) {
+        Write("Tune", "Failed to write " + File.string(), 2, true, true);
+    }
+    Out << "# written by 'vexar tune': fastest of " << Candidates << " configurations, median of " << In->TuneRuns << " runs each\n"
+        << "# later builds of " << In->InputFile.filename().string() << " use these unless overridden on the command line;\n"
+        << "# pass --no-tune-file or delete this file to go back to the defaults\n"
+        << "source=" << SourceHash(In->InputFile) << "\n"
+        << "opt=" << Best.OptimizationLevel << "\n"
+        << "inline-threshold=" << Best.InlineThreshold << "\n"
+        << "inline-rounds=" << Best.InlineRounds << "\n"
+        << "unroll=" << Best.Unroll << "\n"
+        << "vectorize=" << Best.Vectorize << "\n"
+        << "slp-vectorize=" << Best.SLPVectorize << "\n"
+        << "fast-math=" << Best.FastMath << "\n"
+        << "seconds=" << BestSeconds << "\n"
+        << "baseline-seconds=" << Baseline->Seconds << "\n";
+
+    double Speedup = BestSeconds > 0 ? Baseline->Seconds / BestSeconds : 1.0;
+    std::ostringstream Summary;
+    Summary << std::fixed << std::setprecision(2) << Speedup;
+    Write("Tune", "Wrote " + File.string() + ": " + Describe(Best) + " (" + Summary.str() + "x over " + BaselineConfig + ")", 3, true, true);
+    return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CommandLine.hh"
+
+#include <set>
+#include <string>
+#include <vector>
+
+// the pipeline parameters `vexar tune` searches over; written per program to <file>.vxtune
+struct TuneConfig {
+    int OptimizationLevel = 2;
+    int InlineThreshold = -1;
+    int InlineRounds = -1;
+    bool Unroll = true;
+    bool Vectorize = true;
+    bool SLPVectorize = true;
+    bool FastMath = false;
+};
+
+fs::path TuneFileFor(const fs::path& InputFile);
+
+// fills in every setting from <file>.vxtune that was not given on the command line
+void ApplyTuneFile(CLIObject* In, const std::set<std::string>& Explicit);
+
+// `vexar tune <file> [--runs N]`: builds and times the program under each candidate configuration
+int RunTuner(CLIObject* In, const char* Argv0);